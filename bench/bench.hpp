@@ -0,0 +1,20 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+// Runs fn the given number of times and prints the best wall time
+template<typename F>
+double benchmark(const char* name, const int runs, F&& fn) {
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  std::printf("%-40s %10.2f ms\n", name, best);
+  return best;
+}
@@ -0,0 +1,45 @@
+#include <json/json.hpp>
+#include <json/binary.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+// Service-to-service payload: records mixing strings, integers and reals
+static std::string make_records(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"id\": " + std::to_string(i) + ", \"user\": \"user-" + std::to_string(i % 1000) +
+      "\", \"path\": \"/api/v1/items/" + std::to_string(i) + "\", \"status\": 200, \"latency\": " + std::to_string(i * 0.37) +
+      ", \"tags\": [\"alpha\", \"beta\"], \"cached\": false}";
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto text = make_records(200'000);
+  const auto val = json::parse(text);
+  const auto cbor = json::to_cbor(val);
+  const auto msgpack = json::to_msgpack(val);
+  std::size_t sum = 0;
+
+  std::printf("size: text %zu, cbor %zu, msgpack %zu bytes\n", text.size(), cbor.size(), msgpack.size());
+
+  std::string text_out;
+  benchmark("encode text (dump)", 5, [&] { text_out.clear(); val.dump_to(text_out); sum += text_out.size(); });
+  std::vector<std::uint8_t> out;
+  benchmark("encode cbor", 5, [&] { out.clear(); json::to_cbor(val, out); sum += out.size(); });
+  benchmark("encode msgpack", 5, [&] { out.clear(); json::to_msgpack(val, out); sum += out.size(); });
+
+  benchmark("decode text (parse)", 5, [&] { sum += json::parse(text).size(); });
+  benchmark("decode cbor", 5, [&] { sum += json::from_cbor(cbor).size(); });
+  benchmark("decode msgpack", 5, [&] { sum += json::from_msgpack(msgpack).size(); });
+
+  return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+#include <json/json.hpp>
+#include <json/parser_context.hpp>
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+// Small request bodies, parsed one at a time
+static std::vector<std::string> make_requests(const std::size_t count) {
+  std::vector<std::string> requests;
+  requests.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    requests.push_back("{\"id\": " + std::to_string(i) +
+      ", \"user\": \"user-" + std::to_string(i % 100) + "\", \"method\": \"POST\", \"path\": \"/api/v1/items\"" +
+      ", \"tags\": [\"a\", \"b\"], \"limit\": 50, \"dry_run\": false}");
+  }
+  return requests;
+}
+
+int main() {
+  const auto requests = make_requests(200'000);
+  std::size_t sum = 0;
+
+  benchmark("json::parse 200k requests", 5, [&] {
+    for (const auto& request : requests) {
+      sum += json::parse(request).size();
+    }
+  });
+
+  benchmark("json::document 200k requests", 5, [&] {
+    for (const auto& request : requests) {
+      sum += json::document(request).root().size();
+    }
+  });
+
+  json::parser_context ctx;
+  benchmark("parser_context::parse", 5, [&] {
+    for (const auto& request : requests) {
+      sum += ctx.parse(request).size();
+    }
+  });
+
+  benchmark("parser_context::parse_in_arena", 5, [&] {
+    for (const auto& request : requests) {
+      sum += ctx.parse_in_arena(request).size();
+    }
+  });
+
+  return sum == 0 ? 1 : 0;
+}
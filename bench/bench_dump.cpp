@@ -0,0 +1,44 @@
+#include <json/json.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+
+// Array of records, the shape of a typical API response
+static json::value make_records(const std::size_t count) {
+  json::array records;
+  records.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    records.push_back(json::object{
+      { "id", static_cast<double>(i) },
+      { "name", "record " + std::to_string(i) },
+      { "active", i % 2 == 0 },
+      { "score", static_cast<double>(i) * 0.25 },
+      { "tags", json::array{ "alpha", "beta", "gamma" } },
+    });
+  }
+  return records;
+}
+
+// Long strings that need no escaping, plus a few that do
+static json::value make_strings(const std::size_t count) {
+  json::array strings;
+  strings.reserve(count);
+  const std::string clean(200, 'x');
+  for (std::size_t i = 0; i < count; ++i) {
+    strings.push_back(i % 100 == 0 ? clean + "\"quoted\"\n" : clean);
+  }
+  return strings;
+}
+
+int main() {
+  const auto records = make_records(200'000);
+  const auto strings = make_strings(200'000);
+
+  std::string out;
+  benchmark("dump 200k records", 5, [&] { out.clear(); records.dump_to(out); });
+  std::printf("  %zu bytes\n", out.size());
+  benchmark("dump 200k strings", 5, [&] { out.clear(); strings.dump_to(out); });
+  std::printf("  %zu bytes\n", out.size());
+}
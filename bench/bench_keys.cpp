@@ -0,0 +1,48 @@
+#include <json/tape.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+
+// Homogeneous records: every element repeats the same keys
+static std::string make_records(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ",\n";
+    }
+    str += "{\"id\": " + std::to_string(i) +
+      ", \"timestamp\": 1700000000, \"status\": \"ok\", \"latency_ms\": 12, \"region\": \"eu-west\", \"retries\": 0}";
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto records = make_records(1'000'000);
+  std::printf("input: %zu bytes\n", records.size());
+
+  benchmark("tape, plain keys", 5, [&] { json::tape_document doc(records); });
+  benchmark("tape, interned keys", 5, [&] { json::tape_document doc(records, { .intern_keys = true }); });
+
+  const json::tape_document plain(records);
+  const json::tape_document interned(records, { .intern_keys = true });
+  std::printf("string buffer: %zu bytes plain, %zu bytes interned\n", plain.strings().size(), interned.strings().size());
+
+  double sum = 0;
+  benchmark("lookup \"retries\" by string", 5, [&] {
+    for (const auto record : plain.root().get<json::array>()) {
+      sum += record["retries"].get<json::number>().value();
+    }
+  });
+
+  const auto retries = *interned.key("retries");
+  benchmark("lookup \"retries\" by key handle", 5, [&] {
+    for (const auto record : interned.root().get<json::array>()) {
+      sum += record[retries].get<json::number>().value();
+    }
+  });
+
+  return sum < 0 ? 1 : 0;
+}
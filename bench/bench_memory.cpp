@@ -0,0 +1,67 @@
+#include <json/json.hpp>
+
+#include <cstdio>
+#include <memory_resource>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+
+// Counts the bytes held by json::value trees: every container and string allocates
+// through the default memory resource
+class counting_resource : public std::pmr::memory_resource {
+public:
+  std::size_t live{};
+
+private:
+  void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+    live += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override {
+    live -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+static std::string make_numbers(const std::size_t count) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> reals(-1000.0, 1000.0);
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    str += (i != 0 ? "," : "") + std::to_string(reals(rng));
+  }
+  return str + "]";
+}
+
+static std::string make_records(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    str += (i != 0 ? "," : "");
+    str += "{\"id\": " + std::to_string(i) + ", \"name\": \"user " + std::to_string(i) +
+      "\", \"active\": true, \"score\": 12.5, \"tags\": [\"a\", \"b\"], \"parent\": null}";
+  }
+  return str + "]";
+}
+
+static void measure(const char* name, const std::string& src) {
+  counting_resource counter;
+  auto* previous = std::pmr::set_default_resource(&counter);
+  {
+    const json::value parsed = json::parse(src);
+    std::printf("%-30s input %9zu bytes, tree %10zu bytes\n", name, src.size(), counter.live);
+  }
+  std::pmr::set_default_resource(previous);
+}
+
+int main() {
+  std::printf("sizeof(json::value) = %zu\n", sizeof(json::value));
+  measure("1M numbers", make_numbers(1'000'000));
+  measure("200k records", make_records(200'000));
+
+  const auto records = make_records(200'000);
+  benchmark("parse 200k records", 5, [&] { const auto parsed = json::parse(records); });
+}
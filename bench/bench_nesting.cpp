@@ -0,0 +1,42 @@
+#include <json/json.hpp>
+#include <json/sax.hpp>
+
+#include <string>
+
+#include "bench.hpp"
+
+// Every value sits a few containers deep, as in configuration and API payloads
+static std::string make_tree(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"a\": [[1, [2, {\"b\": [3]}]], {\"c\": {\"d\": [[], {}]}}]}";
+  }
+  str += ']';
+  return str;
+}
+
+struct counter {
+  std::size_t events = 0;
+  bool on_null() { ++events; return true; }
+  bool on_bool(bool) { ++events; return true; }
+  bool on_number(double) { ++events; return true; }
+  bool on_string(std::string_view) { ++events; return true; }
+  bool on_key(std::string_view) { ++events; return true; }
+  bool on_start_object() { ++events; return true; }
+  bool on_end_object() { ++events; return true; }
+  bool on_start_array() { ++events; return true; }
+  bool on_end_array() { ++events; return true; }
+};
+
+int main() {
+  const auto tree = make_tree(200'000);
+
+  counter c;
+  benchmark("sax 200k nested records", 5, [&] { json::parse_sax(tree, c); });
+  benchmark("parse 200k nested records", 5, [&] { (void)json::parse(tree); });
+
+  return c.events == 0 ? 1 : 0;
+}
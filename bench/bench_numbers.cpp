@@ -0,0 +1,47 @@
+#include <json/json.hpp>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+
+// Number-heavy arrays, shaped like telemetry samples
+static std::string make_array(const bool integers, const std::size_t count) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> reals(-1000.0, 1000.0);
+  std::uniform_int_distribution<long long> ints(0, 1LL << 40);
+
+  std::string str = "[";
+  char buffer[32];
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    const auto length = integers ?
+      std::snprintf(buffer, sizeof(buffer), "%lld", ints(rng)) :
+      std::snprintf(buffer, sizeof(buffer), "%.17g", reals(rng));
+    str.append(buffer, static_cast<std::size_t>(length));
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto integers = make_array(true, 1'000'000);
+  const auto reals = make_array(false, 1'000'000);
+
+  std::printf("integers: %zu bytes, reals: %zu bytes\n", integers.size(), reals.size());
+
+  benchmark("parse 1M integers", 5, [&] { json::document doc(integers); });
+  benchmark("parse 1M reals", 5, [&] { json::document doc(reals); });
+
+  const json::document integers_doc(integers);
+  const json::document reals_doc(reals);
+
+  std::string out;
+  benchmark("dump 1M integers", 5, [&] { out.clear(); integers_doc.root().dump_to(out); });
+  std::printf("  %zu bytes\n", out.size());
+  benchmark("dump 1M reals", 5, [&] { out.clear(); reals_doc.root().dump_to(out); });
+  std::printf("  %zu bytes\n", out.size());
+}
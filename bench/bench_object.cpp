@@ -0,0 +1,38 @@
+#include <json/json.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+
+// Request-sized objects: a handful of members each
+static std::string make_records(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"id\": " + std::to_string(i) +
+      ", \"user\": \"u\", \"method\": \"GET\", \"path\": \"/\", \"status\": 200, \"bytes\": 512, \"latency\": 3, \"cached\": false}";
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto records = make_records(300'000);
+
+  benchmark("parse 300k records", 5, [&] { json::document doc(records); });
+
+  const json::document doc(records);
+  double sum = 0;
+  benchmark("3 lookups per record", 5, [&] {
+    for (const auto& record : doc.root().get<json::array>()) {
+      sum += record["status"].get<json::number>().value();
+      sum += record["latency"].get<json::number>().value();
+      sum += record["id"].get<json::number>().value();
+    }
+  });
+
+  return sum < 0 ? 1 : 0;
+}
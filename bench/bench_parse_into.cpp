@@ -0,0 +1,88 @@
+#include <json/json.hpp>
+#include <json/reader.hpp>
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+struct request {
+  int id{};
+  std::string user{};
+  std::string path{};
+  int status{};
+  double latency{};
+  bool cached{};
+};
+
+template<>
+class json::serializer<request> {
+public:
+  json::value to_json(const request& r) {
+    return json::object{ {"id", r.id}, {"user", r.user}, {"path", r.path}, {"status", r.status}, {"latency", r.latency}, {"cached", r.cached} };
+  }
+
+  request from_json(const json::value& v) {
+    request r;
+    r.id = v["id"].get<json::number>().as<int>();
+    r.user = v["user"].get<json::string>().value();
+    r.path = v["path"].get<json::string>().value();
+    r.status = v["status"].get<json::number>().as<int>();
+    r.latency = v["latency"].get<json::number>().value();
+    r.cached = v["cached"].get<json::boolean>().value();
+    return r;
+  }
+
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "id", &request::id },
+      json::field{ "user", &request::user },
+      json::field{ "path", &request::path },
+      json::field{ "status", &request::status },
+      json::field{ "latency", &request::latency },
+      json::field{ "cached", &request::cached });
+  }
+};
+
+static std::string make_requests(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"id\": " + std::to_string(i) +
+      ", \"user\": \"u" + std::to_string(i % 100) + "\", \"method\": \"GET\", \"path\": \"/api/items\", \"status\": 200, \"latency\": 3.5, \"cached\": false}";
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto input = make_requests(300'000);
+  std::size_t sum = 0;
+
+  benchmark("parse + from_json 300k records", 5, [&] {
+    const auto root = json::parse(input);
+    const auto& records = root.get<json::array>();
+    std::vector<request> result;
+    result.reserve(records.size());
+    for (const auto& record : records) {
+      result.push_back(record.get<request>());
+    }
+    sum += result.size();
+  });
+
+  benchmark("parse_into 300k records", 5, [&] {
+    std::vector<request> result;
+    json::parse_into(input, result);
+    sum += result.size();
+  });
+
+  std::vector<request> reused;
+  benchmark("parse_into, reused vector", 5, [&] {
+    json::parse_into(input, reused);
+    sum += reused.size();
+  });
+
+  return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+#include <json/json.hpp>
+#include <json/query.hpp>
+
+#include <string>
+
+#include "bench.hpp"
+
+// API responses whose items carry a large payload next to the fields that are read
+static std::string make_corpus(const std::size_t count) {
+  std::string str = "{\"meta\": {\"page\": 1, \"count\": " + std::to_string(count) + "}, \"data\": {\"items\": [";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"id\": " + std::to_string(i) + ", \"name\": \"item " + std::to_string(i) + "\", \"payload\": {\"history\": [";
+    for (int j = 0; j < 8; ++j) {
+      str += (j == 0 ? "" : ",");
+      str += "{\"at\": \"2024-01-0" + std::to_string(j + 1) + "T00:00:00Z\", \"value\": " + std::to_string(j * 1.5) + ", \"note\": \"escaped \\\"text\\\"\"}";
+    }
+    str += "], \"tags\": [\"alpha\", \"beta\", \"gamma\"]}}";
+  }
+  str += "]}}";
+  return str;
+}
+
+int main() {
+  const auto corpus = make_corpus(100'000);
+  double sum = 0;
+
+  benchmark("parse + operator[] 100k items", 5, [&] {
+    const auto root = json::parse(corpus);
+    for (const auto& item : root["data"]["items"].get<json::array>()) {
+      sum += item["id"].get<json::number>().value();
+    }
+  });
+
+  benchmark("document + operator[] 100k items", 5, [&] {
+    const json::document doc(corpus);
+    for (const auto& item : doc.root()["data"]["items"].get<json::array>()) {
+      sum += item["id"].get<json::number>().value();
+    }
+  });
+
+  const json::query q{ "/data/items/*/id", "/meta/count" };
+  benchmark("query /data/items/*/id", 5, [&] {
+    const auto results = q.select(corpus);
+    for (const auto& id : results[0]) {
+      sum += id.get<json::number>().value();
+    }
+  });
+
+  std::printf("corpus: %.1f MB\n", static_cast<double>(corpus.size()) / (1 << 20));
+  return sum < 0 ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+#include <json/json.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+
+// String-heavy records, one string in a hundred has escape sequences
+static std::string make_records(const std::size_t count) {
+  std::string str = "[";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      str += ',';
+    }
+    str += "{\"name\": \"customer number " + std::to_string(i) + "\", \"email\": \"customer" + std::to_string(i) +
+      "@example.com\", \"address\": \"" + (i % 100 == 0 ? "line 1\\nline 2" : "1600 Example Avenue, Springfield") + "\"}";
+  }
+  str += ']';
+  return str;
+}
+
+int main() {
+  const auto records = make_records(500'000);
+  std::printf("input: %zu bytes\n", records.size());
+
+  benchmark("document, copied strings", 5, [&] { json::document doc(records); });
+  benchmark("document, borrowed strings", 5, [&] { json::document doc(records, { .borrow_strings = true }); });
+}
@@ -0,0 +1,69 @@
+#include <json/json.hpp>
+#include <json/writer.hpp>
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+struct response {
+  int id{};
+  std::string user{};
+  std::string path{};
+  int status{};
+  double latency{};
+  bool cached{};
+  std::vector<int> scores{};
+};
+
+template<>
+class json::serializer<response> {
+public:
+  json::value to_json(const response& r) {
+    json::array scores;
+    for (const auto score : r.scores) {
+      scores.push_back(score);
+    }
+    return json::object{ {"id", r.id}, {"user", r.user}, {"path", r.path}, {"status", r.status},
+      {"latency", r.latency}, {"cached", r.cached}, {"scores", std::move(scores)} };
+  }
+
+  response from_json(const json::value&) { return {}; }
+
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "id", &response::id },
+      json::field{ "user", &response::user },
+      json::field{ "path", &response::path },
+      json::field{ "status", &response::status },
+      json::field{ "latency", &response::latency },
+      json::field{ "cached", &response::cached },
+      json::field{ "scores", &response::scores });
+  }
+};
+
+int main() {
+  std::vector<response> responses;
+  for (int i = 0; i < 300'000; ++i) {
+    responses.push_back({ i, "user-" + std::to_string(i % 100), "/api/v1/items", 200, 3.25, i % 2 == 0, { 1, 2, 3 } });
+  }
+  std::size_t sum = 0;
+
+  benchmark("to_json + dump 300k records", 5, [&] {
+    json::array arr;
+    arr.reserve(responses.size());
+    for (const auto& r : responses) {
+      arr.emplace_back(r);
+    }
+    sum += json::value(std::move(arr)).dump().size();
+  });
+
+  std::string out;
+  benchmark("writer 300k records", 5, [&] {
+    out.clear();
+    json::dump_to(out, responses);
+    sum += out.size();
+  });
+
+  return sum == 0 ? 1 : 0;
+}
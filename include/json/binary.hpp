@@ -0,0 +1,29 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace json {
+
+  // Binary encodings of a value, CBOR (RFC 8949) and MessagePack. Whole numbers are
+  // encoded as integers, other numbers as single precision floats when that is exact,
+  // as double precision floats otherwise.
+  //
+  // Decoding accepts any well-formed item made of the types json::value can hold: byte
+  // strings, extension types and non-string keys are rejected, CBOR tags are ignored.
+  // Integers beyond 2^53 are rounded, like in text. The buffer must hold exactly one item.
+
+  std::vector<std::uint8_t> to_cbor(const value& val);
+  // Appends to out
+  void to_cbor(const value& val, std::vector<std::uint8_t>& out);
+  value from_cbor(std::span<const std::uint8_t> data, const parse_options& options = {});
+
+  std::vector<std::uint8_t> to_msgpack(const value& val);
+  // Appends to out
+  void to_msgpack(const value& val, std::vector<std::uint8_t>& out);
+  value from_msgpack(std::span<const std::uint8_t> data, const parse_options& options = {});
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace json {
+
+  // Binds a JSON member name to a data member, see described
+  template<typename T, typename M>
+  struct field {
+    std::string_view name;
+    M T::* member;
+  };
+
+  template<typename T, typename M>
+  field(std::string_view, M T::*) -> field<T, M>;
+
+  // A serializer can list the fields of its type, with a member function returning a
+  // tuple of json::field. parse_into() and the writer then read and write members
+  // straight from and to JSON, without going through a value.
+  template<typename T>
+  concept described = requires(serializer<T> s) {
+    std::tuple_size<decltype(s.fields())>::value;
+  };
+
+  namespace internal {
+
+    template<typename T>
+    struct is_vector : std::false_type {};
+
+    template<typename T, typename A>
+    struct is_vector<std::vector<T, A>> : std::true_type {};
+
+    template<typename T>
+    struct is_optional : std::false_type {};
+
+    template<typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+  }
+
+}
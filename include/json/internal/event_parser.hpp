@@ -0,0 +1,175 @@
+#pragma once
+
+#include <json/json.hpp>
+#include <json/internal/lexer.hpp>
+
+#include <format>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace json::internal {
+
+  // Containers opened by an event_parser, '[' or '{'. Callers that parse repeatedly
+  // can keep one and pass it to every parser so that its storage is reused.
+  using parse_stack = std::vector<char>;
+
+  // Drives a handler (see json::sax_handler) with the events of one value. The parser is
+  // not recursive: nesting is tracked on a parse_stack, which fails once it gets deeper
+  // than max_depth.
+  template<typename Handler>
+  class event_parser {
+  public:
+    event_parser(lexer& lex, Handler& handler, const std::size_t max_depth = default_max_depth, parse_stack* stack = nullptr) :
+      _lexer(lex), _handler(handler), _max_depth(max_depth), _stack(stack ? *stack : _own_stack) {}
+
+    event_parser(const event_parser&) = delete;
+    event_parser& operator=(const event_parser&) = delete;
+
+    // Returns false if the handler stopped the parse
+    bool parse();
+
+  private:
+    lexer& _lexer;
+    Handler& _handler;
+    std::size_t _max_depth;
+    parse_stack _own_stack;
+    parse_stack& _stack;
+
+    bool parse_key();
+    void open(const char container);
+    [[noreturn]] void throw_error(const std::string_view msg);
+  };
+
+  template<typename Handler>
+  void event_parser<Handler>::throw_error(const std::string_view msg) {
+    throw std::runtime_error(std::format("[Parse error at {}:{}]: {}",
+      _lexer.get_current_line(),
+      _lexer.get_current_character(),
+      msg));
+  }
+
+  template<typename Handler>
+  bool event_parser<Handler>::parse_key() {
+    const auto key = _lexer.require_token<token_types::string_literal>();
+    if (!_handler.on_key(key.value)) {
+      return false;
+    }
+    _lexer.require_token<token_types::colon>();
+    return true;
+  }
+
+  template<typename Handler>
+  void event_parser<Handler>::open(const char container) {
+    if (_stack.size() >= _max_depth) {
+      throw_error("Maximum nesting depth exceeded");
+    }
+    _stack.push_back(container);
+  }
+
+  template<typename Handler>
+  bool event_parser<Handler>::parse() {
+    _stack.clear();
+
+    while (true) {
+
+      // A value is expected: scalars are reported, containers are opened
+      auto tok = _lexer.next_token();
+
+      if (tok == token_types::open_square{}) {
+        open('[');
+        if (!_handler.on_start_array()) {
+          return false;
+        }
+        if (_lexer.peek_token() != token_types::close_square{}) {
+          continue;
+        }
+        _lexer.next_token();
+        _stack.pop_back();
+        if (!_handler.on_end_array()) {
+          return false;
+        }
+      }
+      else if (tok == token_types::open_curly{}) {
+        open('{');
+        if (!_handler.on_start_object()) {
+          return false;
+        }
+        if (_lexer.peek_token() != token_types::close_curly{}) {
+          if (!parse_key()) {
+            return false;
+          }
+          continue;
+        }
+        _lexer.next_token();
+        _stack.pop_back();
+        if (!_handler.on_end_object()) {
+          return false;
+        }
+      }
+      else if (tok == token_types::null_value{}) {
+        if (!_handler.on_null()) {
+          return false;
+        }
+      }
+      else if (auto str = std::get_if<token_types::string_literal>(&tok); str) {
+        if (!_handler.on_string(str->value)) {
+          return false;
+        }
+      }
+      else if (auto bln = std::get_if<token_types::boolean_literal>(&tok); bln) {
+        if (!_handler.on_bool(bln->value)) {
+          return false;
+        }
+      }
+      else if (auto num = std::get_if<token_types::number_literal>(&tok); num) {
+        if (!_handler.on_number(num->value)) {
+          return false;
+        }
+      }
+      else if (tok == token_types::eof{}) {
+        throw_error("Unexpected end of input");
+      }
+      else {
+        throw_error("Unexpected token");
+      }
+
+      // A value is complete: close containers until one continues with a comma. The
+      // input after the outermost value is left to the caller.
+      while (true) {
+        if (_stack.empty()) {
+          return true;
+        }
+
+        const auto next = _lexer.next_token();
+        const bool in_array = _stack.back() == '[';
+
+        if (next == token_types::comma{}) {
+          if (!in_array && !parse_key()) {
+            return false;
+          }
+          break;
+        }
+        else if (in_array && next == token_types::close_square{}) {
+          _stack.pop_back();
+          if (!_handler.on_end_array()) {
+            return false;
+          }
+        }
+        else if (!in_array && next == token_types::close_curly{}) {
+          _stack.pop_back();
+          if (!_handler.on_end_object()) {
+            return false;
+          }
+        }
+        else if (next == token_types::eof{}) {
+          throw_error("Unexpected end of input");
+        }
+        else {
+          throw_error("Unexpected token");
+        }
+      }
+    }
+  }
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <json/internal/simd.hpp>
+
 #include <istream>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <optional>
 
@@ -29,7 +32,9 @@ namespace json::internal {
 
     struct number_literal { double value{}; };
 
-    struct string_literal { std::string value; };
+    // Points into the input, or into the lexer's scratch buffer for strings with escape
+    // sequences: only valid until the lexer produces its next token
+    struct string_literal { std::string_view value; };
 
     struct boolean_literal { bool value{}; }; 
 
@@ -78,22 +83,32 @@ namespace json::internal {
     return static_cast<const token_variant_t&>(lhs) != static_cast<const token_variant_t&>(rhs);
   }
 
-
   class lexer {
   public:
 
     struct marked_position {
-      std::size_t cur_line{}, cur_char{};
-      std::istream::pos_type stream_pos{};
+      std::size_t offset{};
     };
 
-    lexer(std::istream& in) : _in(in) {}
+    lexer(std::string_view in) : _begin(in.data()), _cur(in.data()), _end(in.data() + in.size()) {}
+
+    // Walks the token starts of a prebuilt structural index instead of skipping whitespace
+    lexer(std::string_view in, const structural_index& index) : lexer(in) { _index = &index; }
+
+    // Adapter for stream input: the stream is buffered once, then lexed in place
+    lexer(std::istream& in);
+
+    lexer(const lexer&) = delete;
+    lexer& operator=(const lexer&) = delete;
+
     token next_token();
-    token peek_token();
+
+    // The peeked token is kept in a lookahead slot, so each token is lexed exactly once
+    const token& peek_token();
 
     template<typename T>
     T require_token() {
-      const auto tok = next_token();
+      auto tok = next_token();
       if (std::holds_alternative<T>(tok)) {
         return std::move(std::get<T>(tok));
       }
@@ -104,18 +119,37 @@ namespace json::internal {
     }
 
     void reset(const marked_position& pos);
+
+    // Starts over on new input, the scratch buffer keeps its capacity
+    void assign(std::string_view in);
     marked_position mark();
 
-    std::size_t get_current_line() const { return _cur_line; }
-    std::size_t get_current_character() const { return _cur_char; }
+    // Line and character are computed on demand, they are only needed for error reporting
+    std::size_t get_current_line() const;
+    std::size_t get_current_character() const;
 
   private:
+    token lex_token();
+    const char* position() const { return _lookahead ? _lookahead_start : _cur; }
+    void skip_whitespace();
     char peek();
     char next();
     void expect(const char c);
-    void throw_error(const std::string_view msg);
-    std::size_t _cur_char{}, _cur_line{};
-    std::istream& _in;
+    void unescape(std::string& out);
+    double lex_number(const char* start);
+    [[noreturn]] void throw_error(const std::string_view msg);
+
+    std::string _buffer{};
+    std::string _scratch{};
+    const char* _begin{};
+    const char* _cur{};
+    const char* _end{};
+
+    const structural_index* _index{};
+    std::size_t _next_structural{};
+
+    std::optional<token> _lookahead{};
+    const char* _lookahead_start{};
   };
 
 }
\ No newline at end of file
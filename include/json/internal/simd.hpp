@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace json::internal {
+
+  enum class simd_level {
+    scalar,
+    sse2,
+    avx2
+  };
+
+  // Best instruction set available on the running CPU, detected once
+  simd_level detected_simd_level();
+
+  // Offsets of every token start in the input: structural characters, opening quotes
+  // and the first character of any other scalar. String contents are never indexed.
+  using structural_index = std::vector<std::uint32_t>;
+
+  // Inputs larger than this cannot be indexed with 32 bit offsets
+  constexpr std::size_t max_indexed_size = UINT32_MAX;
+
+  void build_structural_index(std::string_view in, structural_index& out);
+  void build_structural_index(std::string_view in, structural_index& out, const simd_level level);
+
+  // First '"' or '\\' in [begin, end), or end if there is none
+  const char* find_quote_or_backslash(const char* begin, const char* end);
+  const char* find_quote_or_backslash(const char* begin, const char* end, const simd_level level);
+
+  // First character that must be escaped in a JSON string: '"', '\\' or a control
+  // character below 0x20. Returns end if there is none.
+  const char* find_escape(const char* begin, const char* end);
+  const char* find_escape(const char* begin, const char* end, const simd_level level);
+
+}
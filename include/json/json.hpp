@@ -1,10 +1,19 @@
 #pragma once
 
-#include <unordered_map>
+#include <json/object.hpp>
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
 #include <variant>
 #include <string>
+#include <string_view>
+#include <iosfwd>
+#include <filesystem>
 #include <stdexcept>
 #include <concepts>
+#include <cstdint>
+#include <utility>
 
 namespace json {
 
@@ -21,17 +30,45 @@ namespace json {
     string() = default;
     string(const std::string& value) : _value(value) {}
     string(const std::string_view value) : _value(value) {}
+    string(const std::string_view value, std::pmr::memory_resource* resource) : _value(value, resource) {}
 
     template<std::size_t N>
     string(const char(&value)[N]) : _value(value) {}
 
-    [[nodiscard]] auto operator<=>(const string& other) const { return _value <=> other._value; };
-    [[nodiscard]] bool operator==(const string& other) const = default;
-    [[nodiscard]] bool operator!=(const string& other) const = default;
+    // Refers to characters owned by someone else, they must outlive the string and any
+    // string it is moved to. Copies always own their characters.
+    [[nodiscard]] static string borrowed(const std::string_view value, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+      string result(std::string_view{}, resource);
+      result._borrowed = value;
+      return result;
+    }
+
+    string(const string& other) : _value(other.view()) {}
+    string(string&&) noexcept = default;
+
+    string& operator=(const string& other) {
+      if (this != &other) {
+        _value.assign(other.view());
+        _borrowed = {};
+      }
+      return *this;
+    }
+
+    string& operator=(string&&) = default;
+
+    [[nodiscard]] auto operator<=>(const string& other) const { return view() <=> other.view(); };
+    [[nodiscard]] bool operator==(const string& other) const { return view() == other.view(); }
+    [[nodiscard]] bool operator!=(const string& other) const { return view() != other.view(); }
+
+    [[nodiscard]] std::string value() const { return std::string(view()); }
+    [[nodiscard]] std::string_view view() const { return is_borrowed() ? _borrowed : std::string_view(_value); }
+    [[nodiscard]] bool is_borrowed() const { return _borrowed.data() != nullptr; }
+
+    [[nodiscard]] std::pmr::polymorphic_allocator<char> get_allocator() const { return _value.get_allocator(); }
 
-    [[nodiscard]] std::string value() const { return _value; }
   private:
-    std::string _value{};
+    std::pmr::string _value{};
+    std::string_view _borrowed{};
   };
 
   class number {
@@ -76,16 +113,10 @@ namespace json {
 
   class value;
 
-  using array = std::vector<value>;
-  using object = std::unordered_map<std::string, value>;
-
-  using value_variant_t = std::variant<
-    array,
-    object,
-    null,
-    string,
-    boolean,
-    number>;
+  // Containers and strings allocate from a memory resource: the global heap unless
+  // they belong to a json::document
+  using array = std::pmr::vector<value>;
+  using object = basic_object<value>;
 
   template<typename T>
   struct serializer;
@@ -96,20 +127,77 @@ namespace json {
     { s.from_json(v) } -> std::same_as<T>;
   };
 
-  class value : public value_variant_t {
+  // 16 byte node: null, booleans and numbers are stored inline, strings and containers
+  // are boxed in the memory resource they allocate from, so that arrays and objects of
+  // values stay small. Moving a value moves the box; copies are heap-backed.
+  class value {
   public:
-    using value_variant_t::value_variant_t;
-    using value_variant_t::operator=;
+    // A default constructed value is an empty array. Its box is only allocated once the
+    // array is accessed for modification, so default construction never allocates.
+    value() noexcept : _type(tag::array) { _payload.array_value = nullptr; }
+
+    value(const null) noexcept : _type(tag::null) { std::construct_at(&_payload.null_value); }
+    value(std::nullptr_t) noexcept : value(null{}) {}
+
+    value(const boolean b) noexcept : _type(tag::boolean) { std::construct_at(&_payload.boolean_value, b); }
+
+    template <typename T> requires std::same_as<std::remove_cvref_t<T>, bool>
+    value(const T b) noexcept : value(boolean{ b }) {}
+
+    value(const number n) noexcept : _type(tag::number) { std::construct_at(&_payload.number_value, n); }
+
+    template <typename T> requires ((std::floating_point<T> || std::integral<T>) && !std::same_as<std::remove_cvref_t<T>, bool>)
+    value(const T n) noexcept : value(number{ n }) {}
+
+    value(string str) : _type(tag::string) { _payload.string_value = box(std::move(str)); }
+    value(const std::string& str) : value(string{ str }) {}
+    value(const std::string_view str) : value(string{ str }) {}
+    value(const char* str) : value(string{ std::string_view(str) }) {}
+
+    value(array arr) : _type(tag::array) { _payload.array_value = box(std::move(arr)); }
+    value(object obj) : _type(tag::object) { _payload.object_value = box(std::move(obj)); }
 
     template<typename T>
       requires (serializable<T>)
     value(const T& v) : value(serializer<T>{}.to_json(v)) {}
 
+    value(const value& other) : _type(tag::null) { copy_from(other); }
+
+    value(value&& other) noexcept : _type(other._type), _payload(other._payload) {
+      other._type = tag::null;
+    }
+
+    value& operator=(const value& other) {
+      if (this != &other) {
+        value copy(other);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    value& operator=(value&& other) noexcept {
+      if (this != &other) {
+        release();
+        _type = std::exchange(other._type, tag::null);
+        _payload = other._payload;
+      }
+      return *this;
+    }
+
+    ~value() { release(); }
+
     std::string dump() const;
+
+    // Serialize into a single output without building a string per node. The stream and
+    // file descriptor variants go through a fixed-size buffer that is flushed as it fills.
+    void dump_to(std::string& out) const;
+    void dump_to(std::ostream& out) const;
+    void dump_to_fd(int fd) const;
+
     std::size_t size() const;
 
-    [[nodiscard]] inline value& operator[](const std::string& key) { return get<json::object>().at(key); }
-    [[nodiscard]] inline const value& operator[](const std::string& key) const { return get<json::object>().at(key); }
+    [[nodiscard]] inline value& operator[](const std::string_view key) { return get<json::object>().at(key); }
+    [[nodiscard]] inline const value& operator[](const std::string_view key) const { return get<json::object>().at(key); }
 
     [[nodiscard]] inline value& operator[](const std::size_t index) { return get<json::array>()[index]; }
     [[nodiscard]] inline const value& operator[](const std::size_t index) const { return get<json::array>()[index]; }
@@ -129,42 +217,217 @@ namespace json {
     template<typename T>
       requires (!serializable<T>)
     [[nodiscard]] T& get() {
-      return std::get<T>(*this);
+      if (auto result = get_if<T>(); result) {
+        return *result;
+      }
+      throw std::bad_variant_access();
     }
 
     template<typename T>
       requires (!serializable<T>)
     [[nodiscard]] const T& get() const {
-      return std::get<T>(*this);
+      if (auto result = get_if<T>(); result) {
+        return *result;
+      }
+      throw std::bad_variant_access();
     }
 
     template<typename T>
     [[nodiscard]] bool is() const {
-      return std::holds_alternative<T>(*this);
+      return _type == tag_of<T>();
     }
 
     template<typename T>
       requires (!serializable<T>)
     [[nodiscard]] T* get_if() {
-      return std::get_if<T>(this);
+      if constexpr (std::is_same_v<T, array>) {
+        if (_type == tag::array && _payload.array_value == nullptr) {
+          _payload.array_value = box(array{});
+        }
+      }
+      return const_cast<T*>(std::as_const(*this).get_if<T>());
     }
 
     template<typename T>
       requires (!serializable<T>)
     [[nodiscard]] const T* get_if() const {
-      return std::get_if<T>(this);
+      if (!is<T>()) {
+        return nullptr;
+      }
+      if constexpr (std::is_same_v<T, null>) {
+        return &_payload.null_value;
+      }
+      else if constexpr (std::is_same_v<T, boolean>) {
+        return &_payload.boolean_value;
+      }
+      else if constexpr (std::is_same_v<T, number>) {
+        return &_payload.number_value;
+      }
+      else if constexpr (std::is_same_v<T, string>) {
+        return _payload.string_value;
+      }
+      else if constexpr (std::is_same_v<T, array>) {
+        return _payload.array_value ? _payload.array_value : &no_elements();
+      }
+      else {
+        return _payload.object_value;
+      }
+    }
+
+    // Calls f with the stored json type
+    template<typename F>
+    decltype(auto) visit(F&& f) const {
+      switch (_type) {
+      case tag::array: return f(*get_if<array>());
+      case tag::object: return f(*_payload.object_value);
+      case tag::string: return f(*_payload.string_value);
+      case tag::boolean: return f(_payload.boolean_value);
+      case tag::number: return f(_payload.number_value);
+      default: return f(_payload.null_value);
+      }
+    }
+
+  private:
+    enum class tag : std::uint8_t {
+      array,
+      object,
+      null,
+      string,
+      boolean,
+      number,
+    };
+
+    union payload {
+      payload() : null_value() {}
+
+      null null_value;
+      boolean boolean_value;
+      number number_value;
+      string* string_value;
+      array* array_value;
+      object* object_value;
+    };
+
+    tag _type;
+    payload _payload;
+
+    template<typename T>
+    static constexpr tag tag_of() {
+      if constexpr (std::is_same_v<T, null>) return tag::null;
+      else if constexpr (std::is_same_v<T, boolean>) return tag::boolean;
+      else if constexpr (std::is_same_v<T, number>) return tag::number;
+      else if constexpr (std::is_same_v<T, string>) return tag::string;
+      else if constexpr (std::is_same_v<T, array>) return tag::array;
+      else if constexpr (std::is_same_v<T, object>) return tag::object;
+      else static_assert(sizeof(T) == 0, "not a json value type");
+    }
+
+    // Boxes live in the same resource as the characters or elements they own
+    template<typename T>
+    static T* box(T&& v) {
+      std::pmr::memory_resource* resource = v.get_allocator().resource();
+      return std::construct_at(static_cast<T*>(resource->allocate(sizeof(T), alignof(T))), std::move(v));
+    }
+
+    template<typename T>
+    static void unbox(T* v) {
+      std::pmr::memory_resource* resource = v->get_allocator().resource();
+      std::destroy_at(v);
+      resource->deallocate(v, sizeof(T), alignof(T));
+    }
+
+    // Shared by the default constructed values until they are modified
+    static const array& no_elements() {
+      static const array empty;
+      return empty;
     }
 
+    void release_container() noexcept;
+
+    void release() noexcept {
+      switch (_type) {
+      case tag::array:
+        if (_payload.array_value) {
+          release_container();
+        }
+        break;
+      case tag::object: release_container(); break;
+      case tag::string: unbox(_payload.string_value); break;
+      default: break;
+      }
+      _type = tag::null;
+    }
+
+    void copy_from(const value& other) {
+      switch (other._type) {
+      case tag::array: _payload.array_value = other._payload.array_value ? box(array(*other._payload.array_value)) : nullptr; break;
+      case tag::object: _payload.object_value = box(object(*other._payload.object_value)); break;
+      case tag::string: _payload.string_value = box(string(*other._payload.string_value)); break;
+      default: _payload = other._payload; break;
+      }
+      _type = other._type;
+    }
   };
 
-  [[nodiscard]] inline bool operator==(const value& lhs, const value& rhs) {
-    return static_cast<const value_variant_t&>(lhs) == static_cast<const value_variant_t&>(rhs);
-  }
+  [[nodiscard]] bool operator==(const value& lhs, const value& rhs);
 
   [[nodiscard]] inline bool operator!=(const value& lhs, const value& rhs) {
-    return static_cast<const value_variant_t&>(lhs) != static_cast<const value_variant_t&>(rhs);
+    return !(lhs == rhs);
   }
 
-  value parse(const std::string& str);
+  // Documents nested deeper than this are rejected by default
+  constexpr std::size_t default_max_depth = 1024;
+
+  struct parse_options {
+    // Maximum number of nested arrays and objects. Parsing fails as soon as the input
+    // goes deeper, whatever follows.
+    std::size_t max_depth = default_max_depth;
+  };
+
+  struct document_options {
+    // Strings without escape sequences refer to the input instead of being copied, the
+    // others are decoded once into the arena. The input must then outlive the document.
+    bool borrow_strings = false;
+    std::size_t max_depth = default_max_depth;
+  };
+
+  // A parsed tree whose nodes, keys and strings are all allocated from an arena owned
+  // by the document. The tree is read-only and is released in one go with the arena,
+  // without visiting its nodes. Copying root() gives a regular heap-backed value.
+  class document {
+  public:
+    explicit document(std::string_view str, const document_options& options = {});
+
+    document(document&&) noexcept = default;
+    document& operator=(document&&) noexcept = default;
+
+    [[nodiscard]] const value& root() const { return *_root; }
+    [[nodiscard]] std::pmr::memory_resource* resource() const { return _arena.get(); }
+
+  private:
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> _arena;
+    const value* _root{};
+  };
+
+  value parse(std::string_view str, const parse_options& options = {});
+  value parse(std::istream& in, const parse_options& options = {});
+
+  struct parallel_options {
+    // Number of worker threads, 0 uses every hardware thread
+    std::size_t threads = 0;
+    // Inputs smaller than this are parsed on the calling thread
+    std::size_t min_parallel_size = 1 << 20;
+    // Same limit as parse_options, the root array counts as the first level
+    std::size_t max_depth = default_max_depth;
+  };
+
+  // Parses a document whose root is a large array on several threads: a quick
+  // bracket and quote aware pass finds the top-level elements, which are parsed in
+  // chunks and merged. The result is the same as parse(); other documents are
+  // parsed sequentially.
+  value parse_parallel(std::string_view str, const parallel_options& options = {});
+
+  // Regular files are memory mapped and lexed in place, the mapping is released once parsing is done
+  value parse_file(const std::filesystem::path& path);
 
 }
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace json {
+
+  namespace internal {
+
+    enum class lazy_kind {
+      null,
+      boolean,
+      number,
+      string,
+      array,
+      object,
+    };
+
+    // Position of a value inside the source text
+    struct lazy_ref {
+      const char* begin{};
+      const char* cur{};
+      const char* end{};
+
+      [[nodiscard]] lazy_kind kind() const;
+
+      [[nodiscard]] bool read_boolean() const;
+      [[nodiscard]] double read_number() const;
+      [[nodiscard]] std::string read_string() const;
+
+      // First character after this value. Containers are skipped by bracket matching,
+      // their contents are not validated.
+      [[nodiscard]] const char* skip() const;
+
+      // First element or member of a container, or nullptr if it is empty
+      [[nodiscard]] const char* first_child() const;
+
+      // Next element or member of the container after the child ending at pos, or nullptr
+      [[nodiscard]] const char* next_child(const char* pos) const;
+
+      // Splits a member "key": value into the raw key (escapes not decoded) and the value
+      [[nodiscard]] std::pair<std::string_view, lazy_ref> member() const;
+
+      [[noreturn]] void throw_error(const char* pos, const std::string_view msg) const;
+    };
+
+  }
+
+  class lazy_array;
+  class lazy_object;
+
+  // Handle on a value of a lazy_document. Nothing is parsed until the value is read:
+  // get<number>(), get<string>(), ... convert the value on demand, operator[] and the
+  // container iterators scan forward and skip the subtrees that are not visited.
+  class lazy_value {
+  public:
+    lazy_value() = default;
+    explicit lazy_value(const internal::lazy_ref& ref) : _ref(ref) {}
+
+    template<typename T>
+    [[nodiscard]] bool is() const;
+
+    // Scalars are returned as their json type, containers as lazy_array / lazy_object
+    template<typename T>
+    [[nodiscard]] auto get() const;
+
+    [[nodiscard]] lazy_value operator[](const std::string_view key) const;
+    [[nodiscard]] lazy_value operator[](const std::size_t index) const;
+
+    // Linear in the size of the container
+    [[nodiscard]] std::size_t size() const;
+
+    // Source text of the value
+    [[nodiscard]] std::string_view raw() const { return { _ref.cur, static_cast<std::size_t>(_ref.skip() - _ref.cur) }; }
+
+    // Fully parses the value
+    [[nodiscard]] value to_value() const { return parse(raw()); }
+
+  private:
+    internal::lazy_ref _ref{};
+  };
+
+  class lazy_array {
+  public:
+    class iterator {
+    public:
+      using value_type = lazy_value;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::input_iterator_tag;
+
+      iterator() = default;
+      iterator(const internal::lazy_ref& parent, const char* pos) : _parent(parent), _pos(pos) {}
+
+      [[nodiscard]] lazy_value operator*() const { return lazy_value({ _parent.begin, _pos, _parent.end }); }
+      iterator& operator++() {
+        _pos = _parent.next_child(internal::lazy_ref{ _parent.begin, _pos, _parent.end }.skip());
+        return *this;
+      }
+      iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+      [[nodiscard]] bool operator==(const iterator& other) const { return _pos == other._pos; }
+      [[nodiscard]] bool operator!=(const iterator& other) const { return _pos != other._pos; }
+
+    private:
+      internal::lazy_ref _parent{};
+      const char* _pos{};
+    };
+
+    lazy_array() = default;
+    explicit lazy_array(const internal::lazy_ref& ref) : _ref(ref) {}
+
+    [[nodiscard]] iterator begin() const { return iterator(_ref, _ref.first_child()); }
+    [[nodiscard]] iterator end() const { return iterator(_ref, nullptr); }
+
+    [[nodiscard]] bool empty() const { return _ref.first_child() == nullptr; }
+    [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+    // Linear in the index
+    [[nodiscard]] lazy_value operator[](const std::size_t index) const {
+      auto it = begin();
+      for (std::size_t i = 0; i < index && it != end(); ++i) {
+        ++it;
+      }
+      if (it == end()) {
+        throw std::out_of_range("Index out of range");
+      }
+      return *it;
+    }
+
+  private:
+    internal::lazy_ref _ref{};
+  };
+
+  class lazy_object {
+  public:
+    // Keys are the raw source text, escape sequences are not decoded
+    class iterator {
+    public:
+      using value_type = std::pair<std::string_view, lazy_value>;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::input_iterator_tag;
+
+      iterator() = default;
+      iterator(const internal::lazy_ref& parent, const char* pos) : _parent(parent), _pos(pos) {}
+
+      [[nodiscard]] value_type operator*() const {
+        const auto [key, val] = internal::lazy_ref{ _parent.begin, _pos, _parent.end }.member();
+        return { key, lazy_value(val) };
+      }
+      iterator& operator++() {
+        _pos = _parent.next_child(internal::lazy_ref{ _parent.begin, _pos, _parent.end }.member().second.skip());
+        return *this;
+      }
+      iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+      [[nodiscard]] bool operator==(const iterator& other) const { return _pos == other._pos; }
+      [[nodiscard]] bool operator!=(const iterator& other) const { return _pos != other._pos; }
+
+    private:
+      internal::lazy_ref _parent{};
+      const char* _pos{};
+    };
+
+    lazy_object() = default;
+    explicit lazy_object(const internal::lazy_ref& ref) : _ref(ref) {}
+
+    [[nodiscard]] iterator begin() const { return iterator(_ref, _ref.first_child()); }
+    [[nodiscard]] iterator end() const { return iterator(_ref, nullptr); }
+
+    [[nodiscard]] bool empty() const { return _ref.first_child() == nullptr; }
+    [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+    [[nodiscard]] iterator find(const std::string_view key) const;
+    [[nodiscard]] bool contains(const std::string_view key) const { return find(key) != end(); }
+
+    [[nodiscard]] lazy_value operator[](const std::string_view key) const {
+      const auto it = find(key);
+      if (it == end()) {
+        throw std::out_of_range("Key not found");
+      }
+      return (*it).second;
+    }
+
+  private:
+    internal::lazy_ref _ref{};
+  };
+
+  template<typename T>
+  bool lazy_value::is() const {
+    using internal::lazy_kind;
+    const auto kind = _ref.kind();
+    if constexpr (std::is_same_v<T, null>) {
+      return kind == lazy_kind::null;
+    }
+    else if constexpr (std::is_same_v<T, boolean>) {
+      return kind == lazy_kind::boolean;
+    }
+    else if constexpr (std::is_same_v<T, number>) {
+      return kind == lazy_kind::number;
+    }
+    else if constexpr (std::is_same_v<T, string>) {
+      return kind == lazy_kind::string;
+    }
+    else if constexpr (std::is_same_v<T, array>) {
+      return kind == lazy_kind::array;
+    }
+    else if constexpr (std::is_same_v<T, object>) {
+      return kind == lazy_kind::object;
+    }
+    else {
+      static_assert(sizeof(T) == 0, "not a json value type");
+    }
+  }
+
+  template<typename T>
+  auto lazy_value::get() const {
+    if (!is<T>()) {
+      throw std::bad_variant_access();
+    }
+
+    if constexpr (std::is_same_v<T, null>) {
+      return null{};
+    }
+    else if constexpr (std::is_same_v<T, boolean>) {
+      return boolean{ _ref.read_boolean() };
+    }
+    else if constexpr (std::is_same_v<T, number>) {
+      return number{ _ref.read_number() };
+    }
+    else if constexpr (std::is_same_v<T, string>) {
+      return string{ _ref.read_string() };
+    }
+    else if constexpr (std::is_same_v<T, array>) {
+      return lazy_array(_ref);
+    }
+    else if constexpr (std::is_same_v<T, object>) {
+      return lazy_object(_ref);
+    }
+  }
+
+  inline lazy_value lazy_value::operator[](const std::string_view key) const {
+    return get<object>()[key];
+  }
+
+  inline lazy_value lazy_value::operator[](const std::size_t index) const {
+    return get<array>()[index];
+  }
+
+  inline std::size_t lazy_value::size() const {
+    if (is<array>()) {
+      return get<array>().size();
+    }
+    else if (is<object>()) {
+      return get<object>().size();
+    }
+    else {
+      throw std::runtime_error("size() called on non-container type");
+    }
+  }
+
+  // On-demand view of a JSON text. The text is not copied and must outlive the document
+  // and every handle obtained from it.
+  class lazy_document {
+  public:
+    explicit lazy_document(std::string_view str);
+
+    [[nodiscard]] lazy_value root() const { return lazy_value(_root); }
+    [[nodiscard]] lazy_value operator[](const std::string_view key) const { return root()[key]; }
+    [[nodiscard]] lazy_value operator[](const std::size_t index) const { return root()[index]; }
+
+  private:
+    internal::lazy_ref _root{};
+  };
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+  // Sequentially parses a sequence of whitespace separated documents, such as JSON Lines.
+  // The text is not copied and must outlive the stream.
+  class document_stream {
+  public:
+    class iterator {
+    public:
+      using value_type = value;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::input_iterator_tag;
+
+      iterator() = default;
+      explicit iterator(document_stream* stream) : _stream(stream) { ++(*this); }
+
+      [[nodiscard]] value& operator*() { return _current; }
+      [[nodiscard]] value* operator->() { return &_current; }
+      iterator& operator++() {
+        if (!_stream->next(_current)) {
+          _stream = nullptr;
+        }
+        return *this;
+      }
+      [[nodiscard]] bool operator==(const iterator& other) const { return _stream == other._stream; }
+      [[nodiscard]] bool operator!=(const iterator& other) const { return _stream != other._stream; }
+
+    private:
+      document_stream* _stream{};
+      value _current{};
+    };
+
+    explicit document_stream(std::string_view str, const parse_options& options = {});
+    ~document_stream();
+
+    document_stream(document_stream&&) noexcept;
+    document_stream& operator=(document_stream&&) noexcept;
+
+    // Parses the next document into out, returns false once the input is exhausted
+    bool next(value& out);
+
+    [[nodiscard]] iterator begin() { return iterator(this); }
+    [[nodiscard]] iterator end() { return iterator(); }
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> _impl;
+  };
+
+  using ndjson_options = parallel_options;
+
+  // Parses newline delimited JSON on a pool of worker threads. Every non-blank line must
+  // hold exactly one document, whether the input is parsed sequentially or not. Lines are
+  // split into batches at newline boundaries; the results are returned in input order.
+  std::vector<value> parse_ndjson(std::string_view str, const ndjson_options& options = {});
+
+  // Same, but hands every document to the callback as soon as it is parsed. The callback
+  // is called concurrently from the worker threads, in no particular order.
+  void parse_ndjson(std::string_view str, const std::function<void(value&&)>& callback, const ndjson_options& options = {});
+
+  // Memory maps the file and parses it in place
+  std::vector<value> parse_ndjson_file(const std::filesystem::path& path, const ndjson_options& options = {});
+
+}
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+  // Object members stored contiguously in insertion order. Small objects are searched
+  // linearly, larger ones also keep an open addressing table of member indices. Lookups
+  // take a std::string_view and never allocate.
+  //
+  // Keys are const so that the index cannot be invalidated through iterators. Members are
+  // therefore moved to new storage by copying their key and moving their value.
+  template<typename Value>
+  class basic_object {
+  public:
+    using key_type = std::pmr::string;
+    using mapped_type = Value;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using size_type = std::size_t;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+    using iterator = typename std::pmr::vector<value_type>::iterator;
+    using const_iterator = typename std::pmr::vector<value_type>::const_iterator;
+
+    // Objects up to this size are not indexed
+    static constexpr size_type linear_lookup_limit = 16;
+
+    basic_object() = default;
+    explicit basic_object(const allocator_type& alloc) : _members(alloc), _slots(alloc) {}
+
+    basic_object(std::initializer_list<value_type> members, const allocator_type& alloc = {}) : basic_object(alloc) {
+      reserve(members.size());
+      for (const auto& member : members) {
+        insert(member);
+      }
+    }
+
+    basic_object(const basic_object&) = default;
+    basic_object(basic_object&&) noexcept = default;
+    basic_object(const basic_object& other, const allocator_type& alloc) : _members(other._members, alloc), _slots(other._slots, alloc) {}
+
+    basic_object& operator=(const basic_object& other) {
+      if (this != &other) {
+        basic_object copy(other, get_allocator());
+        _members.swap(copy._members);
+        _slots.swap(copy._slots);
+      }
+      return *this;
+    }
+
+    basic_object& operator=(basic_object&& other) {
+      if (this == &other) {
+        return *this;
+      }
+      if (get_allocator() == other.get_allocator()) {
+        _members.swap(other._members);
+        _slots.swap(other._slots);
+      }
+      else {
+        relocate(other._members, other.size());
+        rebuild_index();
+      }
+      other.clear();
+      return *this;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const { return _members.get_allocator(); }
+
+    [[nodiscard]] iterator begin() { return _members.begin(); }
+    [[nodiscard]] iterator end() { return _members.end(); }
+    [[nodiscard]] const_iterator begin() const { return _members.begin(); }
+    [[nodiscard]] const_iterator end() const { return _members.end(); }
+    [[nodiscard]] const_iterator cbegin() const { return _members.cbegin(); }
+    [[nodiscard]] const_iterator cend() const { return _members.cend(); }
+
+    [[nodiscard]] size_type size() const { return _members.size(); }
+    [[nodiscard]] bool empty() const { return _members.empty(); }
+
+    void reserve(const size_type count) {
+      if (count > _members.capacity()) {
+        relocate(_members, count);
+      }
+    }
+
+    void clear() {
+      _members.clear();
+      _slots.clear();
+    }
+
+    [[nodiscard]] iterator find(const std::string_view key) { return begin() + static_cast<std::ptrdiff_t>(index_of(key)); }
+    [[nodiscard]] const_iterator find(const std::string_view key) const { return begin() + static_cast<std::ptrdiff_t>(index_of(key)); }
+
+    [[nodiscard]] bool contains(const std::string_view key) const { return index_of(key) != size(); }
+    [[nodiscard]] size_type count(const std::string_view key) const { return contains(key) ? 1 : 0; }
+
+    [[nodiscard]] mapped_type& at(const std::string_view key) {
+      const auto index = index_of(key);
+      if (index == size()) {
+        throw std::out_of_range("Key not found");
+      }
+      return _members[index].second;
+    }
+
+    [[nodiscard]] const mapped_type& at(const std::string_view key) const {
+      const auto index = index_of(key);
+      if (index == size()) {
+        throw std::out_of_range("Key not found");
+      }
+      return _members[index].second;
+    }
+
+    template<typename K>
+      requires std::convertible_to<const K&, std::string_view>
+    mapped_type& operator[](K&& key) {
+      return try_emplace(std::forward<K>(key)).first->second;
+    }
+
+    // Inserts the member unless the key is already present
+    template<typename K, typename... Args>
+      requires std::convertible_to<const K&, std::string_view>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+      const auto index = index_of(key);
+      if (index != size()) {
+        return { begin() + static_cast<std::ptrdiff_t>(index), false };
+      }
+      return { append(std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...)), true };
+    }
+
+    template<typename K, typename M>
+      requires std::convertible_to<const K&, std::string_view>
+    std::pair<iterator, bool> emplace(K&& key, M&& mapped) {
+      return try_emplace(std::forward<K>(key), std::forward<M>(mapped));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& member) { return try_emplace(member.first, member.second); }
+    std::pair<iterator, bool> insert(value_type&& member) { return try_emplace(std::move(member.first), std::move(member.second)); }
+
+    template<typename K, typename M>
+      requires std::convertible_to<const K&, std::string_view>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& mapped) {
+      const auto index = index_of(key);
+      if (index != size()) {
+        _members[index].second = std::forward<M>(mapped);
+        return { begin() + static_cast<std::ptrdiff_t>(index), false };
+      }
+      return { append(std::forward<K>(key), std::forward<M>(mapped)), true };
+    }
+
+    // Erasing keeps the order of the remaining members, it is linear in the size
+    iterator erase(const_iterator pos) {
+      const auto index = pos - cbegin();
+      relocate(_members, _members.capacity(), static_cast<size_type>(index));
+      rebuild_index();
+      return begin() + index;
+    }
+
+    size_type erase(const std::string_view key) {
+      const auto it = find(key);
+      if (it == end()) {
+        return 0;
+      }
+      erase(it);
+      return 1;
+    }
+
+    // Members are compared regardless of their order
+    [[nodiscard]] friend bool operator==(const basic_object& lhs, const basic_object& rhs) {
+      if (lhs.size() != rhs.size()) {
+        return false;
+      }
+      return std::all_of(lhs.begin(), lhs.end(), [&rhs](const value_type& member) {
+        const auto it = rhs.find(member.first);
+        return it != rhs.end() && it->second == member.second;
+      });
+    }
+
+  private:
+    static constexpr std::uint32_t empty_slot = 0;
+
+    std::pmr::vector<value_type> _members;
+    // Member index + 1 for each occupied slot, only used past linear_lookup_limit
+    std::pmr::vector<std::uint32_t> _slots;
+
+    static std::size_t hash(const std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+    // Index of the member with the given key, or size() if there is none
+    [[nodiscard]] size_type index_of(const std::string_view key) const {
+      if (_slots.empty()) {
+        for (size_type i = 0; i < _members.size(); ++i) {
+          if (_members[i].first == key) {
+            return i;
+          }
+        }
+        return size();
+      }
+
+      const auto mask = _slots.size() - 1;
+      for (auto slot = hash(key) & mask; _slots[slot] != empty_slot; slot = (slot + 1) & mask) {
+        const auto index = _slots[slot] - 1;
+        if (_members[index].first == key) {
+          return index;
+        }
+      }
+      return size();
+    }
+
+    // Moves the members of from, except the one at skip, to new storage of the given capacity
+    void relocate(std::pmr::vector<value_type>& from, const size_type capacity, const size_type skip = static_cast<size_type>(-1)) {
+      std::pmr::vector<value_type> members(get_allocator());
+      members.reserve(capacity);
+      for (size_type i = 0; i < from.size(); ++i) {
+        if (i != skip) {
+          members.emplace_back(from[i].first, std::move(from[i].second));
+        }
+      }
+      _members.swap(members);
+    }
+
+    // The vector never grows by itself, it would copy the values along with the const keys.
+    // When it is full the member is built first, as the arguments may refer to other members.
+    template<typename... Args>
+    iterator append(Args&&... args) {
+      if (_members.size() < _members.capacity()) {
+        _members.emplace_back(std::forward<Args>(args)...);
+      }
+      else {
+        auto member = std::make_obj_using_allocator<value_type>(get_allocator(), std::forward<Args>(args)...);
+        relocate(_members, std::max<size_type>(4, _members.capacity() * 2));
+        _members.emplace_back(member.first, std::move(member.second));
+      }
+      return indexed();
+    }
+
+    // Indexes the member that was just appended
+    iterator indexed() {
+      if (_members.size() > linear_lookup_limit) {
+        // Keep the table at most half full
+        if (_members.size() * 2 > _slots.size()) {
+          rebuild_index();
+        }
+        else {
+          insert_slot(_members.size() - 1);
+        }
+      }
+      return end() - 1;
+    }
+
+    void insert_slot(const size_type index) {
+      const auto mask = _slots.size() - 1;
+      auto slot = hash(_members[index].first) & mask;
+      while (_slots[slot] != empty_slot) {
+        slot = (slot + 1) & mask;
+      }
+      _slots[slot] = static_cast<std::uint32_t>(index + 1);
+    }
+
+    void rebuild_index() {
+      _slots.clear();
+      if (_members.size() <= linear_lookup_limit) {
+        return;
+      }
+      _slots.resize(std::bit_ceil(_members.size() * 4), empty_slot);
+      for (size_type i = 0; i < _members.size(); ++i) {
+        insert_slot(i);
+      }
+    }
+  };
+
+}
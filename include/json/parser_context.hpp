@@ -0,0 +1,40 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <memory>
+#include <string_view>
+
+namespace json {
+
+  // Long-lived parser state for workloads that parse many small documents. The lexer
+  // scratch buffer, the container stack and the builder storage are kept between calls,
+  // as is an arena for parse_in_arena(). Once warmed up on similarly shaped documents,
+  // parse_in_arena() does not allocate at all.
+  //
+  // A context is not thread-safe, use one per thread.
+  class parser_context {
+  public:
+    explicit parser_context(const parse_options& options = {});
+    ~parser_context();
+
+    parser_context(parser_context&&) noexcept;
+    parser_context& operator=(parser_context&&) noexcept;
+
+    // Returns a regular heap-backed value, only the nodes of the result are allocated
+    value parse(std::string_view str);
+
+    // Builds the value in the context's arena. The arena is recycled by the next call,
+    // which invalidates the previous result; the returned value must not outlive the
+    // context either. Strings are copied, the input can be released right away.
+    const value& parse_in_arena(std::string_view str);
+
+    // Bytes of arena currently set aside for parse_in_arena()
+    [[nodiscard]] std::size_t arena_capacity() const;
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> _impl;
+  };
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace json {
+
+  // Incremental parser for input that arrives in arbitrary fragments, such as a socket.
+  // Partial tokens and open containers are kept between calls, so only the value being
+  // built is held in memory. The input may contain any number of top-level values.
+  class push_parser {
+  public:
+    explicit push_parser(const parse_options& options = {});
+    ~push_parser();
+
+    push_parser(push_parser&&) noexcept;
+    push_parser& operator=(push_parser&&) noexcept;
+
+    // Consumes the next fragment and returns the top-level values it completed.
+    // Throws on malformed input, the parser cannot be used afterwards.
+    std::vector<value> feed(std::span<const char> chunk);
+
+    // Signals the end of the input: completes a pending top-level number and
+    // throws if a value is still incomplete
+    std::vector<value> finish();
+
+    // True when no value is partially parsed
+    [[nodiscard]] bool idle() const;
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> _impl;
+  };
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+  namespace internal {
+
+    // One step of the compiled pointers. The pointers sharing a prefix share its nodes.
+    struct query_node {
+      static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+      // Reference token and node index
+      std::vector<std::pair<std::string, std::size_t>> children;
+      std::size_t wildcard = none;
+      // Pointers that end at this node
+      std::vector<std::size_t> targets;
+    };
+
+  }
+
+  // A set of JSON Pointers (RFC 6901) compiled once and evaluated in a single pass over
+  // a document. Only the values the pointers select are parsed, every other subtree is
+  // skipped by bracket matching, without being validated or allocated for. A "*" token
+  // matches every element of an array or member of an object, as in /data/items/*/id.
+  class query {
+  public:
+    query(std::initializer_list<std::string_view> pointers);
+    explicit query(const std::vector<std::string>& pointers);
+
+    // Number of pointers
+    [[nodiscard]] std::size_t size() const { return _count; }
+
+    // The values selected by each pointer, in the order of the pointers, each in document
+    // order. Pointers that select nothing get an empty list. The depth limit counts the
+    // containers the selected values are nested in.
+    [[nodiscard]] std::vector<std::vector<value>> select(std::string_view str, const parse_options& options = {}) const;
+
+  private:
+    std::vector<internal::query_node> _nodes;
+    std::size_t _count{};
+
+    void add(std::string_view pointer);
+  };
+
+}
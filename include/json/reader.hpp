@@ -0,0 +1,135 @@
+#pragma once
+
+#include <json/json.hpp>
+#include <json/fields.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace json {
+
+  // Pulls the values of a document one token at a time, without building a tree. Any
+  // value of the wrong kind throws, as does malformed input.
+  class reader {
+  public:
+    enum class kind {
+      null,
+      boolean,
+      number,
+      string,
+      array,
+      object,
+    };
+
+    explicit reader(std::string_view str, const parse_options& options = {});
+    ~reader();
+
+    reader(reader&&) noexcept;
+    reader& operator=(reader&&) noexcept;
+
+    // Kind of the next value, without consuming it
+    [[nodiscard]] kind peek();
+
+    void read_null();
+    bool read_bool();
+    double read_number();
+
+    // Valid until the next call on the reader
+    std::string_view read_string();
+
+    // Reads the next value, whatever its kind, into a regular value
+    value read_value();
+
+    // Skips the next value, containers included. The skipped input is still validated.
+    void skip();
+
+    // Iterate over an array with: begin_array(); while (next_element()) { read ... }
+    void begin_array();
+    bool next_element();
+
+    // Iterate over an object with: begin_object(); while (auto key = next_key()) { read ... }
+    // The key is valid until the next call on the reader.
+    void begin_object();
+    std::optional<std::string_view> next_key();
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> _impl;
+  };
+
+  // Reads the next value of the reader into target. Supported targets are bool, numbers,
+  // std::string, json::value, std::vector and std::optional of supported types, described
+  // types, and serializable types (through a temporary value).
+  //
+  // Elements already in a vector are overwritten in place, so reading into the same
+  // target repeatedly reuses its storage. Members of a described type that are missing
+  // from the input are left untouched, unknown keys are skipped.
+  template<typename T>
+  void read_into(reader& r, T& target) {
+    if constexpr (std::is_same_v<T, value>) {
+      target = r.read_value();
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+      target = r.read_bool();
+    }
+    else if constexpr (std::is_arithmetic_v<T>) {
+      target = static_cast<T>(r.read_number());
+    }
+    else if constexpr (std::is_same_v<T, std::string>) {
+      target.assign(r.read_string());
+    }
+    else if constexpr (internal::is_vector<T>::value) {
+      std::size_t count = 0;
+      r.begin_array();
+      while (r.next_element()) {
+        if (count == target.size()) {
+          target.emplace_back();
+        }
+        read_into(r, target[count++]);
+      }
+      target.resize(count);
+    }
+    else if constexpr (internal::is_optional<T>::value) {
+      if (r.peek() == reader::kind::null) {
+        r.read_null();
+        target.reset();
+      }
+      else {
+        read_into(r, target ? *target : target.emplace());
+      }
+    }
+    else if constexpr (described<T>) {
+      const auto fields = serializer<T>{}.fields();
+      r.begin_object();
+      while (const auto key = r.next_key()) {
+        const bool found = std::apply([&](const auto&... f) {
+          return ((f.name == *key && (read_into(r, target.*f.member), true)) || ...);
+        }, fields);
+        if (!found) {
+          r.skip();
+        }
+      }
+    }
+    else if constexpr (serializable<T>) {
+      target = serializer<T>{}.from_json(r.read_value());
+    }
+    else {
+      static_assert(!sizeof(T), "Type cannot be read from JSON");
+    }
+  }
+
+  // Parses one value straight into target, without building a tree
+  template<typename T>
+  void parse_into(const std::string_view str, T& target, const parse_options& options = {}) {
+    reader r(str, options);
+    read_into(r, target);
+  }
+
+}
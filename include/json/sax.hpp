@@ -0,0 +1,55 @@
+#pragma once
+
+#include <json/json.hpp>
+#include <json/internal/event_parser.hpp>
+
+#include <concepts>
+#include <string_view>
+
+namespace json {
+
+  // Receives the parse events of a document. Every callback returns false to stop parsing.
+  // Strings and keys are only valid for the duration of the callback.
+  template<typename H>
+  concept sax_handler = requires(H & h, const bool b, const double d, const std::string_view s) {
+    { h.on_null() } -> std::convertible_to<bool>;
+    { h.on_bool(b) } -> std::convertible_to<bool>;
+    { h.on_number(d) } -> std::convertible_to<bool>;
+    { h.on_string(s) } -> std::convertible_to<bool>;
+    { h.on_key(s) } -> std::convertible_to<bool>;
+    { h.on_start_object() } -> std::convertible_to<bool>;
+    { h.on_end_object() } -> std::convertible_to<bool>;
+    { h.on_start_array() } -> std::convertible_to<bool>;
+    { h.on_end_array() } -> std::convertible_to<bool>;
+  };
+
+  // Runtime-polymorphic handler: override the events you are interested in, the others
+  // are ignored
+  class sax_handler_interface {
+  public:
+    virtual ~sax_handler_interface() = default;
+
+    virtual bool on_null() { return true; }
+    virtual bool on_bool(const bool) { return true; }
+    virtual bool on_number(const double) { return true; }
+    virtual bool on_string(const std::string_view) { return true; }
+    virtual bool on_key(const std::string_view) { return true; }
+    virtual bool on_start_object() { return true; }
+    virtual bool on_end_object() { return true; }
+    virtual bool on_start_array() { return true; }
+    virtual bool on_end_array() { return true; }
+  };
+
+  // Parses one value and reports it to the handler. Returns false if the handler stopped
+  // the parse, throws on malformed input.
+  bool parse_sax(std::string_view str, sax_handler_interface& handler);
+
+  // Handlers known at compile time are called directly, without going through the interface
+  template<sax_handler H>
+    requires (!std::derived_from<H, sax_handler_interface>)
+  bool parse_sax(std::string_view str, H& handler) {
+    internal::lexer lex(str);
+    return internal::event_parser<H>(lex, handler).parse();
+  }
+
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <json/json.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+  namespace internal {
+
+    // Each tape entry stores its type in the upper 8 bits and a 56 bit payload:
+    // - strings: offset of the string in the string buffer (32 bit length followed by the bytes)
+    // - interned keys: key id in bits 32..55 and the 32 bit offset of the key in the string buffer
+    // - numbers: nothing, the double is stored in the following entry
+    // - container starts: element count in bits 32..55 (saturated) and index of the matching end
+    // - container ends: index of the matching start
+    enum class tape_type : std::uint8_t {
+      null = 'n',
+      true_value = 't',
+      false_value = 'f',
+      number = 'd',
+      string = '"',
+      key = 'k',
+      start_array = '[',
+      end_array = ']',
+      start_object = '{',
+      end_object = '}',
+    };
+
+    constexpr std::uint64_t tape_payload_mask = (std::uint64_t{ 1 } << 56) - 1;
+    constexpr std::uint64_t tape_index_mask = 0xFFFFFFFF;
+    constexpr std::uint64_t tape_max_count = 0xFFFFFF;
+    constexpr std::uint64_t tape_max_key_id = 0xFFFFFF;
+
+    constexpr std::uint64_t make_tape_entry(const tape_type type, const std::uint64_t payload) {
+      return (static_cast<std::uint64_t>(type) << 56) | (payload & tape_payload_mask);
+    }
+
+    constexpr tape_type tape_type_of(const std::uint64_t entry) {
+      return static_cast<tape_type>(entry >> 56);
+    }
+
+    constexpr std::uint64_t tape_payload_of(const std::uint64_t entry) {
+      return entry & tape_payload_mask;
+    }
+
+    struct tape_key_hash {
+      using is_transparent = void;
+      std::size_t operator()(const std::string_view str) const { return std::hash<std::string_view>{}(str); }
+    };
+
+    // Interned key -> key id
+    using tape_key_table = std::unordered_map<std::string, std::uint32_t, tape_key_hash, std::equal_to<>>;
+
+    // Position of a value inside a tape
+    struct tape_ref {
+      const std::uint64_t* tape{};
+      const char* strings{};
+      std::size_t index{};
+
+      [[nodiscard]] std::uint64_t entry() const { return tape[index]; }
+      [[nodiscard]] tape_type type() const { return tape_type_of(entry()); }
+
+      // Index of the entry that follows this value
+      [[nodiscard]] std::size_t next_index() const {
+        switch (type()) {
+        case tape_type::number: return index + 2;
+        case tape_type::start_array:
+        case tape_type::start_object: return static_cast<std::size_t>(entry() & tape_index_mask) + 1;
+        default: return index + 1;
+        }
+      }
+
+      [[nodiscard]] std::string_view string() const {
+        const auto payload = tape_payload_of(entry());
+        const char* str = strings + (type() == tape_type::key ? payload & tape_index_mask : payload);
+        std::uint32_t length;
+        std::memcpy(&length, str, sizeof(length));
+        return { str + sizeof(length), length };
+      }
+
+      [[nodiscard]] std::size_t count() const {
+        const auto count = static_cast<std::size_t>(tape_payload_of(entry()) >> 32);
+        if (count < tape_max_count) {
+          return count;
+        }
+
+        // Too many elements to fit the entry: walk the container
+        const auto end = static_cast<std::size_t>(entry() & tape_index_mask);
+        std::size_t result = 0;
+        for (tape_ref it{ tape, strings, index + 1 }; it.index != end; it.index = it.next_index()) {
+          if (type() == tape_type::start_object) {
+            it.index = it.next_index(); // Skip the key
+          }
+          ++result;
+        }
+        return result;
+      }
+    };
+
+  }
+
+  class array_view;
+  class object_view;
+
+  // Interned object key of a tape_document, compared by id. Only meaningful for the
+  // document that produced it.
+  class key_handle {
+  public:
+    key_handle() = default;
+    explicit key_handle(const std::uint32_t id) : _id(id) {}
+
+    [[nodiscard]] std::uint32_t id() const { return _id; }
+    [[nodiscard]] bool operator==(const key_handle& other) const = default;
+
+  private:
+    std::uint32_t _id{};
+  };
+
+  // Read-only view of a value stored in a tape_document. Views are only obtained from a
+  // document, there is no empty view.
+  class value_view {
+  public:
+    value_view() = delete;
+    explicit value_view(const internal::tape_ref& ref) : _ref(ref) {}
+
+    template<typename T>
+    [[nodiscard]] bool is() const;
+
+    // Scalars are returned by value, strings as std::string_view, containers as views
+    template<typename T>
+    [[nodiscard]] auto get() const;
+
+    [[nodiscard]] value_view operator[](const std::string_view key) const;
+    [[nodiscard]] value_view operator[](const key_handle key) const;
+    [[nodiscard]] value_view operator[](const std::size_t index) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    // Materializes the viewed subtree as a heap-backed value
+    [[nodiscard]] value to_value() const;
+
+  private:
+    internal::tape_ref _ref{};
+  };
+
+  class array_view {
+  public:
+    class iterator {
+    public:
+      using value_type = value_view;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      iterator() = default;
+      explicit iterator(const internal::tape_ref& ref) : _ref(ref) {}
+
+      [[nodiscard]] value_view operator*() const { return value_view(_ref); }
+      iterator& operator++() { _ref.index = _ref.next_index(); return *this; }
+      iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+      [[nodiscard]] bool operator==(const iterator& other) const { return _ref.index == other._ref.index; }
+      [[nodiscard]] bool operator!=(const iterator& other) const { return _ref.index != other._ref.index; }
+
+    private:
+      internal::tape_ref _ref{};
+    };
+
+    array_view() = delete;
+    explicit array_view(const internal::tape_ref& ref) : _ref(ref) {}
+
+    [[nodiscard]] iterator begin() const { return iterator({ _ref.tape, _ref.strings, _ref.index + 1 }); }
+    [[nodiscard]] iterator end() const { return iterator({ _ref.tape, _ref.strings, _ref.next_index() - 1 }); }
+
+    [[nodiscard]] std::size_t size() const { return _ref.count(); }
+    [[nodiscard]] bool empty() const { return _ref.next_index() == _ref.index + 2; }
+
+    // Linear in the index
+    [[nodiscard]] value_view operator[](const std::size_t index) const {
+      auto it = begin();
+      for (std::size_t i = 0; i < index; ++i) {
+        ++it;
+      }
+      return *it;
+    }
+
+  private:
+    internal::tape_ref _ref{};
+  };
+
+  class object_view {
+  public:
+    class iterator {
+    public:
+      using value_type = std::pair<std::string_view, value_view>;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      iterator() = default;
+      explicit iterator(const internal::tape_ref& ref) : _ref(ref) {}
+
+      [[nodiscard]] value_type operator*() const {
+        return { _ref.string(), value_view({ _ref.tape, _ref.strings, _ref.index + 1 }) };
+      }
+      iterator& operator++() {
+        _ref.index = internal::tape_ref{ _ref.tape, _ref.strings, _ref.index + 1 }.next_index();
+        return *this;
+      }
+      iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+      [[nodiscard]] bool operator==(const iterator& other) const { return _ref.index == other._ref.index; }
+      [[nodiscard]] bool operator!=(const iterator& other) const { return _ref.index != other._ref.index; }
+
+      // Tape entry of the current key
+      [[nodiscard]] std::uint64_t entry() const { return _ref.entry(); }
+
+    private:
+      internal::tape_ref _ref{};
+    };
+
+    object_view() = delete;
+    explicit object_view(const internal::tape_ref& ref) : _ref(ref) {}
+
+    [[nodiscard]] iterator begin() const { return iterator({ _ref.tape, _ref.strings, _ref.index + 1 }); }
+    [[nodiscard]] iterator end() const { return iterator({ _ref.tape, _ref.strings, _ref.next_index() - 1 }); }
+
+    [[nodiscard]] std::size_t size() const { return _ref.count(); }
+    [[nodiscard]] bool empty() const { return _ref.next_index() == _ref.index + 2; }
+
+    // Like json::parse, the last of duplicate keys wins, so every member is visited
+    [[nodiscard]] iterator find(const std::string_view key) const {
+      const auto last = end();
+      auto found = last;
+      for (auto it = begin(); it != last; ++it) {
+        if ((*it).first == key) {
+          found = it;
+        }
+      }
+      return found;
+    }
+
+    // Compares key ids only, without touching the key strings
+    [[nodiscard]] iterator find(const key_handle key) const {
+      const auto entry = internal::make_tape_entry(internal::tape_type::key, std::uint64_t{ key.id() } << 32);
+      const auto last = end();
+      auto found = last;
+      for (auto it = begin(); it != last; ++it) {
+        if ((it.entry() & ~internal::tape_index_mask) == entry) {
+          found = it;
+        }
+      }
+      return found;
+    }
+
+    [[nodiscard]] bool contains(const std::string_view key) const { return find(key) != end(); }
+    [[nodiscard]] bool contains(const key_handle key) const { return find(key) != end(); }
+
+    // Linear in the number of members
+    [[nodiscard]] value_view operator[](const std::string_view key) const { return at(find(key)); }
+    [[nodiscard]] value_view operator[](const key_handle key) const { return at(find(key)); }
+
+  private:
+    internal::tape_ref _ref{};
+
+    [[nodiscard]] value_view at(const iterator it) const {
+      if (it == end()) {
+        throw std::out_of_range("Key not found");
+      }
+      return (*it).second;
+    }
+  };
+
+  template<typename T>
+  bool value_view::is() const {
+    using internal::tape_type;
+    const auto type = _ref.type();
+    if constexpr (std::is_same_v<T, null>) {
+      return type == tape_type::null;
+    }
+    else if constexpr (std::is_same_v<T, boolean>) {
+      return type == tape_type::true_value || type == tape_type::false_value;
+    }
+    else if constexpr (std::is_same_v<T, number>) {
+      return type == tape_type::number;
+    }
+    else if constexpr (std::is_same_v<T, string>) {
+      return type == tape_type::string;
+    }
+    else if constexpr (std::is_same_v<T, array>) {
+      return type == tape_type::start_array;
+    }
+    else if constexpr (std::is_same_v<T, object>) {
+      return type == tape_type::start_object;
+    }
+    else {
+      static_assert(sizeof(T) == 0, "not a json value type");
+    }
+  }
+
+  template<typename T>
+  auto value_view::get() const {
+    if (!is<T>()) {
+      throw std::bad_variant_access();
+    }
+
+    if constexpr (std::is_same_v<T, null>) {
+      return null{};
+    }
+    else if constexpr (std::is_same_v<T, boolean>) {
+      return boolean{ _ref.type() == internal::tape_type::true_value };
+    }
+    else if constexpr (std::is_same_v<T, number>) {
+      double result;
+      std::memcpy(&result, &_ref.tape[_ref.index + 1], sizeof(result));
+      return number{ result };
+    }
+    else if constexpr (std::is_same_v<T, string>) {
+      return _ref.string();
+    }
+    else if constexpr (std::is_same_v<T, array>) {
+      return array_view(_ref);
+    }
+    else if constexpr (std::is_same_v<T, object>) {
+      return object_view(_ref);
+    }
+  }
+
+  inline value_view value_view::operator[](const std::string_view key) const {
+    return get<object>()[key];
+  }
+
+  inline value_view value_view::operator[](const key_handle key) const {
+    return get<object>()[key];
+  }
+
+  inline value_view value_view::operator[](const std::size_t index) const {
+    return get<array>()[index];
+  }
+
+  inline std::size_t value_view::size() const {
+    if (is<array>() || is<object>()) {
+      return _ref.count();
+    }
+    else {
+      throw std::runtime_error("size() called on non-container type");
+    }
+  }
+
+  struct tape_options {
+    // Store each distinct object key once in a per-document key table. Objects then
+    // refer to their keys by id, which can be looked up with key_handle.
+    bool intern_keys = false;
+    std::size_t max_depth = default_max_depth;
+  };
+
+  // A parsed document stored as one flat tape of 64 bit entries plus a string buffer.
+  // Walking it is a linear scan over memory.
+  class tape_document {
+  public:
+    explicit tape_document(std::string_view str, const tape_options& options = {});
+
+    [[nodiscard]] value_view root() const { return value_view({ _tape.data(), _strings.data(), 0 }); }
+
+    // Handle of an interned key, or nullopt if no object of the document has that key
+    // or keys are not interned
+    [[nodiscard]] std::optional<key_handle> key(const std::string_view key) const {
+      const auto it = _keys.find(key);
+      return it != _keys.end() ? std::optional(key_handle(it->second)) : std::nullopt;
+    }
+
+    // Number of distinct interned keys
+    [[nodiscard]] std::size_t key_count() const { return _keys.size(); }
+
+    [[nodiscard]] const std::vector<std::uint64_t>& tape() const { return _tape; }
+    [[nodiscard]] const std::vector<char>& strings() const { return _strings; }
+
+  private:
+    std::vector<std::uint64_t> _tape;
+    std::vector<char> _strings;
+    internal::tape_key_table _keys;
+  };
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <json/json.hpp>
+#include <json/fields.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace json {
+
+  // Appends JSON to a string as it is described, without building a value. Commas and
+  // colons are inserted by the writer; the sequence of calls is not validated, an
+  // object key must precede each of its members.
+  class writer {
+  public:
+    explicit writer(std::string& out) : _out(out) {}
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(std::string_view name);
+
+    void value(std::nullptr_t);
+    void value(bool b);
+    void value(double d);
+    void value(std::int64_t i);
+    void value(std::uint64_t i);
+    void value(std::string_view str);
+    void value(const char* str) { value(std::string_view(str)); }
+    void value(const std::string& str) { value(std::string_view(str)); }
+    void value(const json::value& val);
+
+    template<typename T>
+      requires (std::integral<T> && !std::same_as<T, bool>)
+    void value(const T i) {
+      if constexpr (std::is_signed_v<T>) {
+        value(static_cast<std::int64_t>(i));
+      }
+      else {
+        value(static_cast<std::uint64_t>(i));
+      }
+    }
+
+    // Appends text that is already valid JSON
+    void raw(std::string_view json);
+
+  private:
+    std::string& _out;
+    bool _separate = false;
+
+    void separator();
+  };
+
+  // A serializer can write its type itself with a write(json::writer&, const T&) member
+  template<typename T>
+  concept writable = requires(serializer<T> s, writer & w, const T & t) {
+    s.write(w, t);
+  };
+
+  // Writes source to w. Supported sources are bool, numbers, strings, json::value,
+  // std::vector and std::optional of supported types (an empty optional is null),
+  // writable types, described types and serializable types (through a temporary value).
+  template<typename T>
+  void write_into(writer& w, const T& source) {
+    if constexpr (std::is_same_v<T, value> || std::is_arithmetic_v<T>) {
+      w.value(source);
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      w.value(std::string_view(source));
+    }
+    else if constexpr (std::is_same_v<T, string>) {
+      w.value(source.view());
+    }
+    else if constexpr (internal::is_vector<T>::value) {
+      w.begin_array();
+      for (const auto& el : source) {
+        write_into(w, el);
+      }
+      w.end_array();
+    }
+    else if constexpr (internal::is_optional<T>::value) {
+      if (source) {
+        write_into(w, *source);
+      }
+      else {
+        w.value(nullptr);
+      }
+    }
+    else if constexpr (writable<T>) {
+      serializer<T>{}.write(w, source);
+    }
+    else if constexpr (described<T>) {
+      const auto fields = serializer<T>{}.fields();
+      w.begin_object();
+      std::apply([&](const auto&... f) {
+        ((w.key(f.name), write_into(w, source.*f.member)), ...);
+      }, fields);
+      w.end_object();
+    }
+    else if constexpr (serializable<T>) {
+      w.value(serializer<T>{}.to_json(source));
+    }
+    else {
+      static_assert(!sizeof(T), "Type cannot be written as JSON");
+    }
+  }
+
+  // Appends the JSON text of source to out
+  template<typename T>
+  void dump_to(std::string& out, const T& source) {
+    writer w(out);
+    write_into(w, source);
+  }
+
+  template<typename T>
+  [[nodiscard]] std::string dump(const T& source) {
+    std::string result;
+    dump_to(result, source);
+    return result;
+  }
+
+}
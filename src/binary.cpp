@@ -0,0 +1,600 @@
+#include <json/binary.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+  namespace {
+
+    class byte_output {
+    public:
+      explicit byte_output(std::vector<std::uint8_t>& out) : _out(out) {}
+
+      void put(const std::uint8_t b) { _out.push_back(b); }
+
+      template<typename T>
+      void put_big_endian(const T v) {
+        std::uint8_t bytes[sizeof(T)];
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+          bytes[i] = static_cast<std::uint8_t>(v >> (8 * (sizeof(T) - 1 - i)));
+        }
+        _out.insert(_out.end(), bytes, bytes + sizeof(T));
+      }
+
+      void write(const std::string_view str) {
+        const auto offset = _out.size();
+        _out.resize(offset + str.size());
+        std::memcpy(_out.data() + offset, str.data(), str.size());
+      }
+
+    private:
+      std::vector<std::uint8_t>& _out;
+    };
+
+    class byte_input {
+    public:
+      byte_input(const std::span<const std::uint8_t> data, const std::size_t max_depth) :
+        _begin(data.data()), _cur(data.data()), _end(data.data() + data.size()), _max_depth(max_depth) {}
+
+      [[noreturn]] void throw_error(const std::string_view msg) const {
+        throw std::runtime_error(std::format("[Parse error at offset {}]: {}", _cur - _begin, msg));
+      }
+
+      [[nodiscard]] std::size_t remaining() const { return static_cast<std::size_t>(_end - _cur); }
+
+      std::uint8_t peek() const {
+        if (_cur == _end) {
+          throw_error("Unexpected end of input");
+        }
+        return *_cur;
+      }
+
+      std::uint8_t next() {
+        const auto b = peek();
+        ++_cur;
+        return b;
+      }
+
+      template<typename T>
+      T big_endian() {
+        if (remaining() < sizeof(T)) {
+          throw_error("Unexpected end of input");
+        }
+        T v{};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+          v = static_cast<T>((v << 8) | _cur[i]);
+        }
+        _cur += sizeof(T);
+        return v;
+      }
+
+      std::string_view bytes(const std::uint64_t size) {
+        if (remaining() < size) {
+          throw_error("Unexpected end of input");
+        }
+        const std::string_view result(reinterpret_cast<const char*>(_cur), static_cast<std::size_t>(size));
+        _cur += size;
+        return result;
+      }
+
+      // Every element takes at least a byte, which bounds what a length prefix can reserve
+      [[nodiscard]] std::size_t reservable(const std::uint64_t count) const {
+        return static_cast<std::size_t>(std::min<std::uint64_t>(count, remaining()));
+      }
+
+      void enter(const std::size_t depth) const {
+        if (depth >= _max_depth) {
+          throw_error("Maximum nesting depth exceeded");
+        }
+      }
+
+    private:
+      const std::uint8_t* _begin;
+      const std::uint8_t* _cur;
+      const std::uint8_t* _end;
+      std::size_t _max_depth;
+    };
+
+    // Whole numbers in the range of the integer encodings are written as integers
+    bool is_unsigned_integer(const double d) {
+      return d >= 0 && d < 0x1p64 && d == std::trunc(d) && !(d == 0 && std::signbit(d));
+    }
+
+    bool is_float_exact(const double d) {
+      return std::isnan(d) || static_cast<double>(static_cast<float>(d)) == d;
+    }
+
+    // CBOR
+
+    void cbor_head(byte_output& out, const std::uint8_t major, const std::uint64_t n) {
+      const auto type = static_cast<std::uint8_t>(major << 5);
+      if (n < 24) {
+        out.put(static_cast<std::uint8_t>(type | n));
+      }
+      else if (n <= UINT8_MAX) {
+        out.put(type | 24);
+        out.put(static_cast<std::uint8_t>(n));
+      }
+      else if (n <= UINT16_MAX) {
+        out.put(type | 25);
+        out.put_big_endian(static_cast<std::uint16_t>(n));
+      }
+      else if (n <= UINT32_MAX) {
+        out.put(type | 26);
+        out.put_big_endian(static_cast<std::uint32_t>(n));
+      }
+      else {
+        out.put(type | 27);
+        out.put_big_endian(n);
+      }
+    }
+
+    void cbor_number(byte_output& out, const double d) {
+      if (is_unsigned_integer(d)) {
+        cbor_head(out, 0, static_cast<std::uint64_t>(d));
+      }
+      else if (d < 0 && is_unsigned_integer(-d)) {
+        // Major type 1 holds -1 - n, subtracted after the conversion since -d - 1 is
+        // not exact past 2^53
+        cbor_head(out, 1, static_cast<std::uint64_t>(-d) - 1);
+      }
+      else if (is_float_exact(d)) {
+        out.put(0xfa);
+        out.put_big_endian(std::bit_cast<std::uint32_t>(static_cast<float>(d)));
+      }
+      else {
+        out.put(0xfb);
+        out.put_big_endian(std::bit_cast<std::uint64_t>(d));
+      }
+    }
+
+    void cbor_value(byte_output& out, const value& val) {
+      val.visit([&out]<typename T>(const T & v) {
+        if constexpr (std::is_same_v<T, null>) {
+          out.put(0xf6);
+        }
+        else if constexpr (std::is_same_v<T, boolean>) {
+          out.put(v.value() ? 0xf5 : 0xf4);
+        }
+        else if constexpr (std::is_same_v<T, number>) {
+          cbor_number(out, v.value());
+        }
+        else if constexpr (std::is_same_v<T, string>) {
+          cbor_head(out, 3, v.view().size());
+          out.write(v.view());
+        }
+        else if constexpr (std::is_same_v<T, array>) {
+          cbor_head(out, 4, v.size());
+          for (const auto& el : v) {
+            cbor_value(out, el);
+          }
+        }
+        else if constexpr (std::is_same_v<T, object>) {
+          cbor_head(out, 5, v.size());
+          for (const auto& [key, member] : v) {
+            cbor_head(out, 3, key.size());
+            out.write(key);
+            cbor_value(out, member);
+          }
+        }
+      });
+    }
+
+    // Half precision, RFC 8949 appendix D
+    double decode_half(const std::uint16_t half) {
+      const int exponent = (half >> 10) & 0x1f;
+      const int mantissa = half & 0x3ff;
+      double d;
+      if (exponent == 0) {
+        d = std::ldexp(mantissa, -24);
+      }
+      else if (exponent != 31) {
+        d = std::ldexp(mantissa + 1024, exponent - 25);
+      }
+      else {
+        d = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+      }
+      return (half & 0x8000) ? -d : d;
+    }
+
+    class cbor_reader {
+    public:
+      static constexpr std::uint8_t indefinite = 31;
+      static constexpr std::uint8_t break_code = 0xff;
+
+      explicit cbor_reader(byte_input& in) : _in(in) {}
+
+      value read(const std::size_t depth) {
+        const auto initial = _in.next();
+        const auto major = initial >> 5;
+        const auto info = static_cast<std::uint8_t>(initial & 0x1f);
+
+        switch (major) {
+        case 0: return number(static_cast<double>(argument(info)));
+        case 1: return number(-1.0 - static_cast<double>(argument(info)));
+        case 2: _in.throw_error("Byte strings are not supported");
+        case 3: {
+          std::string scratch;
+          return string(text(info, scratch));
+        }
+        case 4: return read_array(info, depth);
+        case 5: return read_map(info, depth);
+        case 6:
+          // The tagged item is decoded as if untagged
+          argument(info);
+          _in.enter(depth);
+          return read(depth + 1);
+        default: return read_simple(info);
+        }
+      }
+
+    private:
+      byte_input& _in;
+
+      std::uint64_t argument(const std::uint8_t info) {
+        switch (info) {
+        case 24: return _in.big_endian<std::uint8_t>();
+        case 25: return _in.big_endian<std::uint16_t>();
+        case 26: return _in.big_endian<std::uint32_t>();
+        case 27: return _in.big_endian<std::uint64_t>();
+        default:
+          if (info < 24) {
+            return info;
+          }
+          _in.throw_error("Invalid additional information");
+        }
+      }
+
+      bool at_break() {
+        if (_in.peek() == break_code) {
+          _in.next();
+          return true;
+        }
+        return false;
+      }
+
+      // Definite strings are returned in place, indefinite ones are joined into scratch
+      std::string_view text(const std::uint8_t info, std::string& scratch) {
+        if (info != indefinite) {
+          return _in.bytes(argument(info));
+        }
+        while (!at_break()) {
+          const auto chunk = _in.next();
+          if ((chunk >> 5) != 3 || (chunk & 0x1f) == indefinite) {
+            _in.throw_error("Invalid string chunk");
+          }
+          scratch += _in.bytes(argument(chunk & 0x1f));
+        }
+        return scratch;
+      }
+
+      value read_array(const std::uint8_t info, const std::size_t depth) {
+        _in.enter(depth);
+        array result;
+        if (info == indefinite) {
+          while (!at_break()) {
+            result.push_back(read(depth + 1));
+          }
+        }
+        else {
+          const auto count = argument(info);
+          result.reserve(_in.reservable(count));
+          for (std::uint64_t i = 0; i < count; ++i) {
+            result.push_back(read(depth + 1));
+          }
+        }
+        return result;
+      }
+
+      value read_map(const std::uint8_t info, const std::size_t depth) {
+        _in.enter(depth);
+        object result;
+        std::string scratch;
+        const auto member = [&] {
+          const auto initial = _in.next();
+          if ((initial >> 5) != 3) {
+            _in.throw_error("Object keys must be strings");
+          }
+          scratch.clear();
+          std::pmr::string key(text(initial & 0x1f, scratch));
+          result.insert_or_assign(std::move(key), read(depth + 1));
+        };
+
+        if (info == indefinite) {
+          while (!at_break()) {
+            member();
+          }
+        }
+        else {
+          const auto count = argument(info);
+          result.reserve(_in.reservable(count));
+          for (std::uint64_t i = 0; i < count; ++i) {
+            member();
+          }
+        }
+        return result;
+      }
+
+      value read_simple(const std::uint8_t info) {
+        switch (info) {
+        case 20: return boolean(false);
+        case 21: return boolean(true);
+        case 22:
+        case 23: return null{}; // undefined has no JSON counterpart
+        case 25: return number(decode_half(_in.big_endian<std::uint16_t>()));
+        case 26: return number(static_cast<double>(std::bit_cast<float>(_in.big_endian<std::uint32_t>())));
+        case 27: return number(std::bit_cast<double>(_in.big_endian<std::uint64_t>()));
+        case indefinite: _in.throw_error("Unexpected break");
+        default: _in.throw_error("Unsupported simple value");
+        }
+      }
+    };
+
+    // MessagePack
+
+    void msgpack_number(byte_output& out, const double d) {
+      if (is_unsigned_integer(d)) {
+        const auto n = static_cast<std::uint64_t>(d);
+        if (n <= 0x7f) {
+          out.put(static_cast<std::uint8_t>(n));
+        }
+        else if (n <= UINT8_MAX) {
+          out.put(0xcc);
+          out.put(static_cast<std::uint8_t>(n));
+        }
+        else if (n <= UINT16_MAX) {
+          out.put(0xcd);
+          out.put_big_endian(static_cast<std::uint16_t>(n));
+        }
+        else if (n <= UINT32_MAX) {
+          out.put(0xce);
+          out.put_big_endian(static_cast<std::uint32_t>(n));
+        }
+        else {
+          out.put(0xcf);
+          out.put_big_endian(n);
+        }
+      }
+      else if (d < 0 && d >= -0x1p63 && d == std::trunc(d)) {
+        const auto i = static_cast<std::int64_t>(d);
+        if (i >= -32) {
+          out.put(static_cast<std::uint8_t>(i));
+        }
+        else if (i >= INT8_MIN) {
+          out.put(0xd0);
+          out.put(static_cast<std::uint8_t>(i));
+        }
+        else if (i >= INT16_MIN) {
+          out.put(0xd1);
+          out.put_big_endian(static_cast<std::uint16_t>(i));
+        }
+        else if (i >= INT32_MIN) {
+          out.put(0xd2);
+          out.put_big_endian(static_cast<std::uint32_t>(i));
+        }
+        else {
+          out.put(0xd3);
+          out.put_big_endian(static_cast<std::uint64_t>(i));
+        }
+      }
+      else if (is_float_exact(d)) {
+        out.put(0xca);
+        out.put_big_endian(std::bit_cast<std::uint32_t>(static_cast<float>(d)));
+      }
+      else {
+        out.put(0xcb);
+        out.put_big_endian(std::bit_cast<std::uint64_t>(d));
+      }
+    }
+
+    void msgpack_string(byte_output& out, const std::string_view str) {
+      const auto size = str.size();
+      if (size <= 31) {
+        out.put(static_cast<std::uint8_t>(0xa0 | size));
+      }
+      else if (size <= UINT8_MAX) {
+        out.put(0xd9);
+        out.put(static_cast<std::uint8_t>(size));
+      }
+      else if (size <= UINT16_MAX) {
+        out.put(0xda);
+        out.put_big_endian(static_cast<std::uint16_t>(size));
+      }
+      else if (size <= UINT32_MAX) {
+        out.put(0xdb);
+        out.put_big_endian(static_cast<std::uint32_t>(size));
+      }
+      else {
+        throw std::runtime_error("String too large");
+      }
+      out.write(str);
+    }
+
+    // fix_type holds up to 15 entries, larger containers use the 16 or 32 bit form
+    void msgpack_container(byte_output& out, const std::uint8_t fix_type, const std::uint8_t type16, const std::size_t size) {
+      if (size <= 15) {
+        out.put(static_cast<std::uint8_t>(fix_type | size));
+      }
+      else if (size <= UINT16_MAX) {
+        out.put(type16);
+        out.put_big_endian(static_cast<std::uint16_t>(size));
+      }
+      else if (size <= UINT32_MAX) {
+        out.put(static_cast<std::uint8_t>(type16 + 1));
+        out.put_big_endian(static_cast<std::uint32_t>(size));
+      }
+      else {
+        throw std::runtime_error("Container too large");
+      }
+    }
+
+    void msgpack_value(byte_output& out, const value& val) {
+      val.visit([&out]<typename T>(const T & v) {
+        if constexpr (std::is_same_v<T, null>) {
+          out.put(0xc0);
+        }
+        else if constexpr (std::is_same_v<T, boolean>) {
+          out.put(v.value() ? 0xc3 : 0xc2);
+        }
+        else if constexpr (std::is_same_v<T, number>) {
+          msgpack_number(out, v.value());
+        }
+        else if constexpr (std::is_same_v<T, string>) {
+          msgpack_string(out, v.view());
+        }
+        else if constexpr (std::is_same_v<T, array>) {
+          msgpack_container(out, 0x90, 0xdc, v.size());
+          for (const auto& el : v) {
+            msgpack_value(out, el);
+          }
+        }
+        else if constexpr (std::is_same_v<T, object>) {
+          msgpack_container(out, 0x80, 0xde, v.size());
+          for (const auto& [key, member] : v) {
+            msgpack_string(out, key);
+            msgpack_value(out, member);
+          }
+        }
+      });
+    }
+
+    class msgpack_reader {
+    public:
+      explicit msgpack_reader(byte_input& in) : _in(in) {}
+
+      value read(const std::size_t depth) {
+        const auto type = _in.next();
+
+        if (type <= 0x7f) {
+          return number(type);
+        }
+        if (type >= 0xe0) {
+          return number(static_cast<std::int8_t>(type));
+        }
+        if ((type & 0xe0) == 0xa0) {
+          return string(_in.bytes(type & 0x1f));
+        }
+        if ((type & 0xf0) == 0x90) {
+          return read_array(type & 0x0f, depth);
+        }
+        if ((type & 0xf0) == 0x80) {
+          return read_map(type & 0x0f, depth);
+        }
+
+        switch (type) {
+        case 0xc0: return null{};
+        case 0xc2: return boolean(false);
+        case 0xc3: return boolean(true);
+        case 0xca: return number(static_cast<double>(std::bit_cast<float>(_in.big_endian<std::uint32_t>())));
+        case 0xcb: return number(std::bit_cast<double>(_in.big_endian<std::uint64_t>()));
+        case 0xcc: return number(_in.big_endian<std::uint8_t>());
+        case 0xcd: return number(_in.big_endian<std::uint16_t>());
+        case 0xce: return number(_in.big_endian<std::uint32_t>());
+        case 0xcf: return number(_in.big_endian<std::uint64_t>());
+        case 0xd0: return number(static_cast<std::int8_t>(_in.big_endian<std::uint8_t>()));
+        case 0xd1: return number(static_cast<std::int16_t>(_in.big_endian<std::uint16_t>()));
+        case 0xd2: return number(static_cast<std::int32_t>(_in.big_endian<std::uint32_t>()));
+        case 0xd3: return number(static_cast<std::int64_t>(_in.big_endian<std::uint64_t>()));
+        case 0xd9: return string(_in.bytes(_in.big_endian<std::uint8_t>()));
+        case 0xda: return string(_in.bytes(_in.big_endian<std::uint16_t>()));
+        case 0xdb: return string(_in.bytes(_in.big_endian<std::uint32_t>()));
+        case 0xdc: return read_array(_in.big_endian<std::uint16_t>(), depth);
+        case 0xdd: return read_array(_in.big_endian<std::uint32_t>(), depth);
+        case 0xde: return read_map(_in.big_endian<std::uint16_t>(), depth);
+        case 0xdf: return read_map(_in.big_endian<std::uint32_t>(), depth);
+        case 0xc4:
+        case 0xc5:
+        case 0xc6: _in.throw_error("Binary data is not supported");
+        default: _in.throw_error("Extension types are not supported");
+        }
+      }
+
+    private:
+      byte_input& _in;
+
+      std::string_view key() {
+        const auto type = _in.next();
+        if ((type & 0xe0) == 0xa0) {
+          return _in.bytes(type & 0x1f);
+        }
+        switch (type) {
+        case 0xd9: return _in.bytes(_in.big_endian<std::uint8_t>());
+        case 0xda: return _in.bytes(_in.big_endian<std::uint16_t>());
+        case 0xdb: return _in.bytes(_in.big_endian<std::uint32_t>());
+        default: _in.throw_error("Object keys must be strings");
+        }
+      }
+
+      value read_array(const std::size_t count, const std::size_t depth) {
+        _in.enter(depth);
+        array result;
+        result.reserve(_in.reservable(count));
+        for (std::size_t i = 0; i < count; ++i) {
+          result.push_back(read(depth + 1));
+        }
+        return result;
+      }
+
+      value read_map(const std::size_t count, const std::size_t depth) {
+        _in.enter(depth);
+        object result;
+        result.reserve(_in.reservable(count));
+        for (std::size_t i = 0; i < count; ++i) {
+          std::pmr::string k(key());
+          result.insert_or_assign(std::move(k), read(depth + 1));
+        }
+        return result;
+      }
+    };
+
+    template<typename Reader>
+    value decode(const std::span<const std::uint8_t> data, const parse_options& options) {
+      byte_input in(data, options.max_depth);
+      value result = Reader(in).read(0);
+      if (in.remaining() != 0) {
+        in.throw_error("Unexpected trailing bytes");
+      }
+      return result;
+    }
+
+  }
+
+  std::vector<std::uint8_t> to_cbor(const value& val) {
+    std::vector<std::uint8_t> result;
+    to_cbor(val, result);
+    return result;
+  }
+
+  void to_cbor(const value& val, std::vector<std::uint8_t>& out) {
+    byte_output output(out);
+    cbor_value(output, val);
+  }
+
+  value from_cbor(const std::span<const std::uint8_t> data, const parse_options& options) {
+    return decode<cbor_reader>(data, options);
+  }
+
+  std::vector<std::uint8_t> to_msgpack(const value& val) {
+    std::vector<std::uint8_t> result;
+    to_msgpack(val, result);
+    return result;
+  }
+
+  void to_msgpack(const value& val, std::vector<std::uint8_t>& out) {
+    byte_output output(out);
+    msgpack_value(output, val);
+  }
+
+  value from_msgpack(const std::span<const std::uint8_t> data, const parse_options& options) {
+    return decode<msgpack_reader>(data, options);
+  }
+
+}
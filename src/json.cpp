@@ -1,34 +1,23 @@
 #include <json/json.hpp>
 
-#include <sstream>
-#include <iomanip>
-#include <ranges>
 #include <algorithm>
-#include <iterator>
-#include <format>
+#include <ostream>
+#include <new>
+#include <tuple>
+#include <vector>
 
 #include "parser.hpp"
+#include "mapped_file.hpp"
+#include "output.hpp"
+#include "write.hpp"
 
 namespace json {
 
-  template<typename R, typename OutIter, typename Value = std::ranges::range_value_t<R>>
-    requires (std::ranges::range<R>&& std::output_iterator<OutIter, Value>)
-  static void join_with(R&& r, const Value& separator, OutIter iter) {
-    if (!std::ranges::empty(r)) {
-      *iter++ = *(std::ranges::begin(r));
-    }
-
-    for (const auto& el : r | std::views::drop(1)) {
-      *iter++ = separator;
-      *iter++ = el;
-    }
-  }
-
   std::size_t value::size() const {
-    if (std::holds_alternative<array>(*this)) {
+    if (is<array>()) {
       return get<array>().size();
     }
-    else if (std::holds_alternative<object>(*this)) {
+    else if (is<object>()) {
       return get<object>().size();
     }
     else {
@@ -36,63 +25,150 @@ namespace json {
     }
   }
 
-  std::string value::dump() const {
-    return std::visit<std::string>([]<typename T>(const T & val) {
-      if constexpr (std::is_same_v<T, null>) {
-        return "null";
-      }
-      else if constexpr (std::is_same_v<T, boolean>) {
-        return val.value() ? "true" : "false";
+  // Destroying the elements of a container would recurse once per level of nesting, so
+  // nested containers are moved to an explicit stack and released one level at a time
+  void value::release_container() noexcept {
+    const auto is_container = [](const value& v) {
+      return (v._type == tag::array && v._payload.array_value) || v._type == tag::object;
+    };
+    const auto for_each_child = [](value& v, auto&& f) {
+      if (v._type == tag::array) {
+        std::for_each(v._payload.array_value->begin(), v._payload.array_value->end(), f);
       }
-      else if constexpr (std::is_same_v<T, string>) {
-        std::stringstream ss;
-        ss << std::quoted(val.value());
-        return ss.str();
+      else {
+        for (auto& member : *v._payload.object_value) {
+          f(member.second);
+        }
       }
-      else if constexpr (std::is_same_v<T, number>) {
-        return std::to_string(val.value());
+    };
+
+    bool nested = false;
+    for_each_child(*this, [&](const value& child) { nested = nested || is_container(child); });
+    if (!nested) {
+      if (_type == tag::array) {
+        unbox(_payload.array_value);
       }
-      else if constexpr (std::is_same_v<T, object>) {
-        std::string result;
-
-        const auto dumped = val | std::views::transform([](const auto& keyVal) {
-          return std::format("\"{}\":{}", keyVal.first, keyVal.second.dump());
-          });
-        std::vector<std::string> joined;
-        join_with(dumped, ",", std::back_inserter(joined));
-
-        result.append("{");
-        for (auto& j : joined) {
-          result.append(std::move(j));
-        }
-        result.append("}");
-        return result;
+      else {
+        unbox(_payload.object_value);
       }
-      else if constexpr (std::is_same_v<T, array>) {
-        std::string result;
+      _type = tag::null;
+      return;
+    }
 
-        const auto dumped = val | std::views::transform([](const auto& el) { return el.dump(); });
-        std::vector<std::string> joined;
-        join_with(dumped, ",", std::back_inserter(joined));
+    std::vector<value> pending;
+    pending.push_back(std::move(*this));
+    while (!pending.empty()) {
+      // Left without nested containers, so its destructor does not recurse
+      value current = std::move(pending.back());
+      pending.pop_back();
+      for_each_child(current, [&](value& child) {
+        if (is_container(child)) {
+          pending.push_back(std::move(child));
+        }
+      });
+    }
+  }
 
-        result.append("[");
-        for (auto& j : joined) {
-          result.append(std::move(j));
+  bool operator==(const value& lhs, const value& rhs) {
+    // Pairs of nested values left to compare, so that deep trees do not recurse
+    std::vector<std::pair<const value*, const value*>> pending;
+    const value* l = &lhs;
+    const value* r = &rhs;
+    while (true) {
+      const bool equal = l->visit([r, &pending]<typename T>(const T & lv) {
+        const T* rv = r->get_if<T>();
+        if (rv == nullptr) {
+          return false;
+        }
+        if constexpr (std::is_same_v<T, array>) {
+          if (lv.size() != rv->size()) {
+            return false;
+          }
+          for (std::size_t i = 0; i < lv.size(); ++i) {
+            pending.emplace_back(&lv[i], &(*rv)[i]);
+          }
+          return true;
+        }
+        else if constexpr (std::is_same_v<T, object>) {
+          // Members are compared regardless of their order
+          if (lv.size() != rv->size()) {
+            return false;
+          }
+          for (const auto& [key, member] : lv) {
+            const auto it = rv->find(key);
+            if (it == rv->end()) {
+              return false;
+            }
+            pending.emplace_back(&member, &it->second);
+          }
+          return true;
+        }
+        else {
+          return lv == *rv;
         }
-        result.append("]");
-        return result;
+      });
+
+      if (!equal) {
+        return false;
       }
-      else {
-        return "unknown";
-        //static_assert(false, "non-exhaustive visitor");
+      if (pending.empty()) {
+        return true;
       }
-    }, static_cast<value_variant_t>(*this));
+      std::tie(l, r) = pending.back();
+      pending.pop_back();
+    }
+  }
+
+  std::string value::dump() const {
+    std::string result;
+    dump_to(result);
+    return result;
+  }
+
+  void value::dump_to(std::string& out) const {
+    internal::string_output output(out);
+    internal::write_value(output, *this);
+  }
+
+  void value::dump_to(std::ostream& out) const {
+    internal::buffered_output output([&out](const char* data, const std::size_t size) {
+      out.write(data, static_cast<std::streamsize>(size));
+    });
+    internal::write_value(output, *this);
+    output.flush();
+  }
+
+  void value::dump_to_fd(const int fd) const {
+    internal::buffered_output output([fd](const char* data, const std::size_t size) {
+      internal::write_fd(fd, data, size);
+    });
+    internal::write_value(output, *this);
+    output.flush();
+  }
+
+  document::document(std::string_view str, const document_options& options) :
+    _arena(std::make_unique<std::pmr::monotonic_buffer_resource>(std::max<std::size_t>(str.size(), 1024))) {
+    internal::lexer lex(str);
+    internal::dom_builder builder(_arena.get(), options.borrow_strings ? std::optional(str) : std::nullopt);
+    internal::event_parser<internal::dom_builder>(lex, builder, options.max_depth).parse();
+    auto root = builder.take_result();
+    // Never destroyed: every allocation it owns is released with the arena
+    _root = new (_arena->allocate(sizeof(value), alignof(value))) value(std::move(root));
   }
 
-  value parse(const std::string& str) {
-    std::istringstream in(str);
+  value parse(std::string_view str, const parse_options& options) {
+    internal::lexer lex(str);
+    return internal::parser(lex, std::pmr::get_default_resource(), options.max_depth).parse();
+  }
+
+  value parse(std::istream& in, const parse_options& options) {
     internal::lexer lex(in);
-    return internal::parser(lex).parse();
+    return internal::parser(lex, std::pmr::get_default_resource(), options.max_depth).parse();
+  }
+
+  value parse_file(const std::filesystem::path& path) {
+    const internal::mapped_file file(path);
+    return parse(file.contents());
   }
 
 
@@ -0,0 +1,187 @@
+#include <json/lazy.hpp>
+#include <json/internal/lexer.hpp>
+#include <json/internal/simd.hpp>
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace json {
+
+  namespace internal {
+
+    static bool is_space(const char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    static const char* skip_whitespace(const char* p, const char* end) {
+      while (p != end && is_space(*p))
+        ++p;
+      return p;
+    }
+
+    // Lexes the scalar starting at ref.cur with the regular lexer, so that error positions
+    // are relative to the whole document. The token is only valid while read() runs.
+    template<typename F>
+    static auto lex_scalar(const lazy_ref& ref, F&& read) {
+      lexer lex(std::string_view(ref.begin, static_cast<std::size_t>(ref.end - ref.begin)));
+      lex.reset({ .offset = static_cast<std::size_t>(ref.cur - ref.begin) });
+      return read(lex.next_token());
+    }
+
+    void lazy_ref::throw_error(const char* pos, const std::string_view msg) const {
+      const auto line = std::count(begin, pos, '\n');
+      const auto line_start = std::find(std::make_reverse_iterator(pos), std::make_reverse_iterator(begin), '\n').base();
+      throw std::runtime_error(std::format("[Parse error at {}:{}]: {}", line, pos - line_start, msg));
+    }
+
+    lazy_kind lazy_ref::kind() const {
+      if (cur == end) {
+        throw_error(cur, "Unexpected end of input");
+      }
+
+      switch (*cur) {
+      case 'n': return lazy_kind::null;
+      case 't':
+      case 'f': return lazy_kind::boolean;
+      case '"': return lazy_kind::string;
+      case '[': return lazy_kind::array;
+      case '{': return lazy_kind::object;
+      default: {
+        if ((*cur >= '0' && *cur <= '9') || *cur == '-') {
+          return lazy_kind::number;
+        }
+        throw_error(cur, std::format("Unexpected character {}", *cur));
+      }
+      }
+    }
+
+    bool lazy_ref::read_boolean() const {
+      return lex_scalar(*this, [](const token& tok) { return std::get<token_types::boolean_literal>(tok).value; });
+    }
+
+    double lazy_ref::read_number() const {
+      return lex_scalar(*this, [](const token& tok) { return std::get<token_types::number_literal>(tok).value; });
+    }
+
+    std::string lazy_ref::read_string() const {
+      return lex_scalar(*this, [](const token& tok) { return std::string(std::get<token_types::string_literal>(tok).value); });
+    }
+
+    const char* lazy_ref::skip() const {
+
+      // Returns the position after the closing quote of the string whose contents start at p
+      const auto skip_string = [this](const char* p) {
+        while (true) {
+          p = find_quote_or_backslash(p, end);
+          if (end - p < 2) {
+            if (p != end && *p == '"') return p + 1;
+            throw_error(p, "Unexpected end of input");
+          }
+          if (*p == '"') return p + 1;
+          p += 2; // Skip the escaped character
+        }
+      };
+
+      const char* p = cur;
+      if (p == end) {
+        throw_error(p, "Unexpected end of input");
+      }
+
+      switch (*p) {
+      case '"':
+        return skip_string(p + 1);
+      case '[':
+      case '{': {
+        std::size_t depth = 0;
+        while (p != end) {
+          switch (*p) {
+          case '"': p = skip_string(p + 1); continue;
+          case '[': case '{': ++depth; break;
+          case ']': case '}': if (--depth == 0) return p + 1; break;
+          default: break;
+          }
+          ++p;
+        }
+        throw_error(p, "Unexpected end of input");
+      }
+      default:
+        while (p != end && !is_space(*p) && *p != ',' && *p != ']' && *p != '}' && *p != ':')
+          ++p;
+        return p;
+      }
+    }
+
+    const char* lazy_ref::first_child() const {
+      const char close = *cur == '[' ? ']' : '}';
+      const char* p = skip_whitespace(cur + 1, end);
+      if (p == end) {
+        throw_error(p, "Unexpected end of input");
+      }
+      return *p == close ? nullptr : p;
+    }
+
+    const char* lazy_ref::next_child(const char* pos) const {
+      const char close = *cur == '[' ? ']' : '}';
+      const char* p = skip_whitespace(pos, end);
+      if (p == end) {
+        throw_error(p, "Unexpected end of input");
+      }
+      if (*p == close) {
+        return nullptr;
+      }
+      if (*p != ',') {
+        throw_error(p, std::format("Unexpected character {}", *p));
+      }
+      p = skip_whitespace(p + 1, end);
+      if (p == end) {
+        throw_error(p, "Unexpected end of input");
+      }
+      return p;
+    }
+
+    std::pair<std::string_view, lazy_ref> lazy_ref::member() const {
+      if (*cur != '"') {
+        throw_error(cur, std::format("Unexpected character {}", *cur));
+      }
+
+      const char* key_end = skip();
+      const std::string_view key(cur + 1, static_cast<std::size_t>(key_end - cur - 2));
+
+      const char* p = skip_whitespace(key_end, end);
+      if (p == end || *p != ':') {
+        throw_error(p, "Expected :");
+      }
+
+      return { key, lazy_ref{ begin, skip_whitespace(p + 1, end), end } };
+    }
+
+  }
+
+  // Like json::parse, the last of duplicate keys wins, so the whole object is scanned
+  lazy_object::iterator lazy_object::find(const std::string_view key) const {
+    const auto last = end();
+    auto found = last;
+    for (auto it = begin(); it != last; ++it) {
+      const auto raw_key = (*it).first;
+      if (raw_key.find('\\') == std::string_view::npos) {
+        if (raw_key == key) {
+          found = it;
+        }
+      }
+      else if (internal::lazy_ref{ _ref.begin, raw_key.data() - 1, _ref.end }.read_string() == key) {
+        found = it;
+      }
+    }
+    return found;
+  }
+
+  lazy_document::lazy_document(std::string_view str) {
+    _root = { str.data(), str.data(), str.data() + str.size() };
+    _root.cur = internal::skip_whitespace(_root.cur, _root.end);
+    if (_root.cur == _root.end) {
+      _root.throw_error(_root.cur, "Unexpected end of input");
+    }
+  }
+
+}
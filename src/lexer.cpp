@@ -1,62 +1,299 @@
-#include "lexer.hpp"
+#include <json/internal/lexer.hpp>
 
 #include <format>
 #include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include <cmath>
+#include <charconv>
+#include <system_error>
 
 namespace json::internal {
 
+  static bool is_space(const char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+  static bool is_digit(const char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  // Result for a number that from_chars found out of range: infinity if its first significant
+  // digit lies above the units, zero otherwise. Worked out from the digits, since strtod
+  // would depend on the locale.
+  static double out_of_range_value(const char* p, const char* const end, const bool negative) {
+    std::int64_t exponent = 0;
+    bool significant = false;
+    for (; p != end && is_digit(*p); ++p) {
+      if (significant) {
+        ++exponent;
+      }
+      significant = significant || *p != '0';
+    }
+    if (p != end && *p == '.') {
+      for (++p; p != end && is_digit(*p); ++p) {
+        if (!significant) {
+          --exponent;
+          significant = *p != '0';
+        }
+      }
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+      ++p;
+      const bool negative_exponent = *p == '-';
+      if (*p == '+' || *p == '-') {
+        ++p;
+      }
+      // Saturated well past any representable exponent
+      std::int64_t explicit_exponent = 0;
+      for (; p != end; ++p) {
+        explicit_exponent = std::min<std::int64_t>(explicit_exponent * 10 + (*p - '0'), 1'000'000'000);
+      }
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    const double result = exponent > 0 ? HUGE_VAL : 0.0;
+    return negative ? -result : result;
+  }
+
+  static void append_utf8(std::string& out, const std::uint32_t cp) {
+    if (cp < 0x80) {
+      out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+      out += static_cast<char>(0xC0 | (cp >> 6));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+      out += static_cast<char>(0xE0 | (cp >> 12));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+      out += static_cast<char>(0xF0 | (cp >> 18));
+      out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+  lexer::lexer(std::istream& in) :
+    _buffer(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()),
+    _begin(_buffer.data()),
+    _cur(_buffer.data()),
+    _end(_buffer.data() + _buffer.size()) {}
 
   void lexer::throw_error(const std::string_view msg) {
-    throw std::runtime_error(std::format("[Lexing error at {}:{}]: {} ", _cur_line, _cur_char, msg));
+    throw std::runtime_error(std::format("[Lexing error at {}:{}]: {} ", get_current_line(), get_current_character(), msg));
   }
 
   void lexer::expect(const char c) {
-    const auto ret = next();
-    if (ret != c) {
+    if (_cur == _end || next() != c) {
       throw_error(std::format("Unexpected character {}", c));
     }
   }
 
   char lexer::peek() {
-    return _in.peek();
+    return _cur != _end ? *_cur : '\0';
   }
 
   char lexer::next() {
-    char ret;
-    _in.read(&ret, 1);
-    if (ret == '\n') {
-      ++_cur_line;
-      _cur_char = 0;
+    return *_cur++;
+  }
+
+  void lexer::skip_whitespace() {
+    if (!_index) {
+      while (_cur != _end && is_space(*_cur))
+        ++_cur;
+      return;
     }
-    else {
-      ++_cur_char;
+
+    const auto offset = static_cast<std::size_t>(_cur - _begin);
+    const auto& index = *_index;
+    while (_next_structural < index.size() && index[_next_structural] < offset)
+      ++_next_structural;
+
+    const char* next_start = _next_structural < index.size() ? _begin + index[_next_structural] : _end;
+
+    // Anything but whitespace between two token starts is the tail of a malformed
+    // scalar: stay on it so it gets reported
+    if (next_start == _cur || is_space(*_cur)) {
+      _cur = next_start;
+    }
+  }
+
+  void lexer::unescape(std::string& out) {
+
+    const auto read_hex4 = [this]() {
+      std::uint32_t cp = 0;
+      for (int i = 0; i < 4; ++i) {
+        if (_cur == _end) {
+          throw_error("Unexpected end of input");
+        }
+        const char ch = next();
+        cp <<= 4;
+        if (ch >= '0' && ch <= '9') cp |= ch - '0';
+        else if (ch >= 'a' && ch <= 'f') cp |= ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F') cp |= ch - 'A' + 10;
+        else throw_error(std::format("Invalid unicode escape character {}", ch));
+      }
+      return cp;
+    };
+
+    if (_cur == _end) {
+      throw_error("Unexpected end of input");
+    }
+
+    const char ch = next();
+
+    switch (ch) {
+    case '"': out += '"'; break;
+    case '\\': out += '\\'; break;
+    case '/': out += '/'; break;
+    case 'b': out += '\b'; break;
+    case 'f': out += '\f'; break;
+    case 'n': out += '\n'; break;
+    case 'r': out += '\r'; break;
+    case 't': out += '\t'; break;
+    case 'u': {
+      std::uint32_t cp = read_hex4();
+      // Surrogate pair
+      if (cp >= 0xD800 && cp <= 0xDBFF && _end - _cur >= 6 && _cur[0] == '\\' && _cur[1] == 'u') {
+        _cur += 2;
+        const auto low = read_hex4();
+        if (low >= 0xDC00 && low <= 0xDFFF) {
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else {
+          append_utf8(out, cp);
+          cp = low;
+        }
+      }
+      append_utf8(out, cp);
+      break;
+    }
+    default:
+      throw_error(std::format("Invalid escape sequence \\{}", ch));
     }
-    return ret;
   }
 
+  std::size_t lexer::get_current_line() const {
+    return std::count(_begin, position(), '\n');
+  }
+
+  std::size_t lexer::get_current_character() const {
+    const auto pos = position();
+    const auto line_start = std::find(std::make_reverse_iterator(pos), std::make_reverse_iterator(_begin), '\n').base();
+    return pos - line_start;
+  }
 
   void lexer::reset(const marked_position& pos) {
-    _cur_line = pos.cur_line;
-    _cur_char = pos.cur_char;
-    _in.seekg(pos.stream_pos, std::ios_base::beg);
+    _lookahead.reset();
+    _cur = _begin + pos.offset;
+    if (_index) {
+      _next_structural = std::lower_bound(_index->begin(), _index->end(), pos.offset) - _index->begin();
+    }
+  }
+
+  void lexer::assign(const std::string_view in) {
+    _buffer.clear();
+    _begin = in.data();
+    _cur = in.data();
+    _end = in.data() + in.size();
+    _index = nullptr;
+    _next_structural = 0;
+    _lookahead.reset();
   }
 
   lexer::marked_position lexer::mark() {
-    return {
-      .cur_line = _cur_line,
-      .cur_char = _cur_char,
-      .stream_pos = _in.tellg()
-    };
+    return { .offset = static_cast<std::size_t>(position() - _begin) };
+  }
+
+  const token& lexer::peek_token() {
+    if (!_lookahead) {
+      _lookahead_start = _cur;
+      _lookahead = lex_token();
+    }
+    return *_lookahead;
   }
 
-  token lexer::peek_token() {
-    const auto pos = mark();
-    const auto result = next_token();
-    reset(pos);
+  double lexer::lex_number(const char* start) {
+    // -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    _cur = start;
+    const bool negative = peek() == '-';
+    if (negative) {
+      ++_cur;
+    }
+
+    const char* digits_start = _cur;
+    if (!is_digit(peek())) {
+      throw_error("Invalid number");
+    }
+    if (next() != '0') {
+      while (is_digit(peek()))
+        ++_cur;
+    }
+    else if (is_digit(peek())) {
+      throw_error("Leading zeros are not allowed");
+    }
+
+    const auto integer_digits = _cur - digits_start;
+    bool is_integer = true;
+
+    if (peek() == '.') {
+      ++_cur;
+      if (!is_digit(peek())) {
+        throw_error("Invalid number");
+      }
+      while (is_digit(peek()))
+        ++_cur;
+      is_integer = false;
+    }
+
+    if (peek() == 'e' || peek() == 'E') {
+      ++_cur;
+      if (peek() == '+' || peek() == '-') {
+        ++_cur;
+      }
+      if (!is_digit(peek())) {
+        throw_error("Invalid number");
+      }
+      while (is_digit(peek()))
+        ++_cur;
+      is_integer = false;
+    }
+
+    // Integers of up to 19 digits fit in 64 bits, the conversion to double is correctly rounded
+    if (is_integer && integer_digits <= 19) {
+      std::uint64_t mantissa = 0;
+      for (const char* p = digits_start; p != _cur; ++p) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+      }
+      const auto result = static_cast<double>(mantissa);
+      return negative ? -result : result;
+    }
+
+    double result{};
+    const auto [ptr, ec] = std::from_chars(start, _cur, result);
+    if (ec == std::errc::result_out_of_range) {
+      // from_chars leaves the result untouched
+      return out_of_range_value(digits_start, _cur, negative);
+    }
     return result;
   }
 
   token lexer::next_token() {
+    if (_lookahead) {
+      token result = std::move(*_lookahead);
+      _lookahead.reset();
+      return result;
+    }
+    return lex_token();
+  }
+
+  token lexer::lex_token() {
 
     enum class state {
       none = 0,
@@ -67,21 +304,22 @@ namespace json::internal {
       false_value,
     } cur_state = state::none;
 
-    std::string accumulator;
+    // Set once the current string needed unescaping into the scratch buffer
+    bool escaped = false;
+    const char* token_start = _cur;
 
-    while (_in.good()) {
+    while (_cur != _end || cur_state != state::none) {
 
       if (cur_state == state::none) {
 
-        // Skip spaces
-        while (_in.good() && std::isspace(peek()))
-          next();
+        skip_whitespace();
 
         // If eof, no more tokens
-        if (_in.eof()) {
+        if (_cur == _end) {
           return token_types::eof{};
         }
 
+        token_start = _cur;
         const char ch = next();
 
         switch (ch) {
@@ -98,8 +336,7 @@ namespace json::internal {
         case 'f': cur_state = state::false_value; break;
         case '"': cur_state = state::string_literal; break;
         default: {
-          if (std::isdigit(ch) || ch == '.') {
-            accumulator += ch;
+          if (is_digit(ch) || ch == '-') {
             cur_state = state::number_literal;
           }
           else {
@@ -111,30 +348,40 @@ namespace json::internal {
       }
       else if (cur_state == state::string_literal) {
 
-        const char ch = next();
+        const char* run_start = _cur;
+        _cur = find_quote_or_backslash(_cur, _end);
 
-        if (ch == '"') {
-          cur_state = state::none;
-          return token_types::string_literal{ .value = std::exchange(accumulator, "") };
+        if (_cur == _end) {
+          break;
         }
-        else if (ch != '\\') {
-          accumulator += ch;
+
+        // Strings without escapes are returned as views of the input
+        if (!escaped && *_cur == '"') {
+          ++_cur;
+          return token_types::string_literal{ .value = std::string_view(run_start, static_cast<std::size_t>(_cur - 1 - run_start)) };
         }
 
-      }
-      else if (cur_state == state::number_literal) {
+        if (!escaped) {
+          _scratch.clear();
+          escaped = true;
+        }
 
-        const auto ch = peek();
+        // Copy the whole run of plain characters at once
+        _scratch.append(run_start, _cur);
 
-        if (std::isdigit(ch) || ch == '.') {
-          accumulator += ch;
-          next();
+        if (next() == '"') {
+          return token_types::string_literal{ .value = _scratch };
         }
         else {
-          cur_state = state::none;
-          return token_types::number_literal{ .value = std::atof(std::exchange(accumulator, "").c_str()) };
+          unescape(_scratch);
         }
 
+      }
+      else if (cur_state == state::number_literal) {
+
+        cur_state = state::none;
+        return token_types::number_literal{ .value = lex_number(token_start) };
+
       }
       else if (cur_state == state::null_value) {
         expect('u');
@@ -0,0 +1,116 @@
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace json::internal {
+
+  [[noreturn]] static void throw_open_error(const std::filesystem::path& path) {
+    throw std::runtime_error(std::format("Cannot open file {}", path.string()));
+  }
+
+#ifdef _WIN32
+
+  mapped_file::mapped_file(const std::filesystem::path& path) {
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw_open_error(path);
+    }
+
+    LARGE_INTEGER size{};
+    if (GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+      const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+
+    if (_mapping) {
+      _data = static_cast<const char*>(_mapping);
+      _size = static_cast<std::size_t>(size.QuadPart);
+      return;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      throw_open_error(path);
+    }
+    _buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _size = _buffer.size();
+  }
+
+  mapped_file::~mapped_file() {
+    if (_mapping) {
+      UnmapViewOfFile(_mapping);
+    }
+  }
+
+#else
+
+  mapped_file::mapped_file(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw_open_error(path);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      void* mapping = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        ::madvise(mapping, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        _mapping = mapping;
+        _data = static_cast<const char*>(mapping);
+        _size = static_cast<std::size_t>(st.st_size);
+        ::close(fd);
+        return;
+      }
+    }
+
+    // Pipes, sockets and other special files: buffered reads until end of input
+    char chunk[64 * 1024];
+    while (true) {
+      const auto count = ::read(fd, chunk, sizeof(chunk));
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count < 0) {
+        ::close(fd);
+        throw std::runtime_error(std::format("Cannot read file {}", path.string()));
+      }
+      if (count == 0) {
+        break;
+      }
+      _buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+    ::close(fd);
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+  }
+
+  mapped_file::~mapped_file() {
+    if (_mapping) {
+      ::munmap(_mapping, _size);
+    }
+  }
+
+#endif
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace json::internal {
+
+  // Read-only view of a whole file. Regular files are memory mapped, anything else
+  // (pipes, character devices, ...) is read into an owned buffer.
+  class mapped_file {
+  public:
+    explicit mapped_file(const std::filesystem::path& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    [[nodiscard]] std::string_view contents() const { return { _data, _size }; }
+    [[nodiscard]] bool is_mapped() const { return _mapping != nullptr; }
+
+  private:
+    void* _mapping{};
+    const char* _data{};
+    std::size_t _size{};
+    std::string _buffer{};
+  };
+
+}
@@ -0,0 +1,135 @@
+#include <json/ndjson.hpp>
+
+#include <algorithm>
+#include <format>
+
+#include "parser.hpp"
+#include "mapped_file.hpp"
+#include "thread_pool.hpp"
+
+namespace json {
+
+  struct document_stream::impl {
+    internal::lexer lex;
+    std::size_t max_depth;
+    impl(std::string_view str, const std::size_t max_depth) : lex(str), max_depth(max_depth) {}
+  };
+
+  document_stream::document_stream(std::string_view str, const parse_options& options) :
+    _impl(std::make_unique<impl>(str, options.max_depth)) {}
+  document_stream::~document_stream() = default;
+
+  document_stream::document_stream(document_stream&&) noexcept = default;
+  document_stream& document_stream::operator=(document_stream&&) noexcept = default;
+
+  bool document_stream::next(value& out) {
+    if (_impl->lex.peek_token() == internal::token_types::eof{}) {
+      return false;
+    }
+    out = internal::parser(_impl->lex, std::pmr::get_default_resource(), _impl->max_depth).parse();
+    return true;
+  }
+
+  namespace {
+
+    // Cuts the input into roughly equal batches that end on a newline
+    std::vector<std::string_view> split_batches(const std::string_view str, const std::size_t count) {
+      std::vector<std::string_view> batches;
+      const std::size_t target = std::max<std::size_t>(str.size() / count, 1);
+
+      std::size_t pos = 0;
+      while (pos < str.size()) {
+        std::size_t end = std::min(pos + target, str.size());
+        if (end < str.size()) {
+          const auto newline = str.find('\n', end);
+          end = newline == std::string_view::npos ? str.size() : newline + 1;
+        }
+        batches.push_back(str.substr(pos, end - pos));
+        pos = end;
+      }
+
+      return batches;
+    }
+
+    // Parses every non-blank line of the batch as exactly one document, so that the result
+    // does not depend on how the input was split. Errors are reported with their line in
+    // the whole input; exceptions from on_value are left untouched.
+    template<typename F>
+    void parse_lines(const std::string_view str, const std::string_view batch, const std::size_t max_depth, F&& on_value) {
+      internal::lexer lex(std::string_view{});
+      std::size_t pos = 0;
+      while (pos < batch.size()) {
+        const auto newline = batch.find('\n', pos);
+        const auto end = newline == std::string_view::npos ? batch.size() : newline;
+        const auto line = batch.substr(pos, end - pos);
+        pos = end + 1;
+
+        value v;
+        try {
+          lex.assign(line);
+          if (lex.peek_token() == internal::token_types::eof{}) {
+            continue;
+          }
+          v = internal::parser(lex, std::pmr::get_default_resource(), max_depth).parse();
+          lex.require_token<internal::token_types::eof>();
+        }
+        catch (const std::runtime_error& err) {
+          const auto number = std::count(str.data(), line.data(), '\n') + 1;
+          throw std::runtime_error(std::format("[Line {}] {}", number, err.what()));
+        }
+        on_value(std::move(v));
+      }
+    }
+
+  }
+
+  std::vector<value> parse_ndjson(std::string_view str, const ndjson_options& options) {
+    const auto threads = internal::thread_count(options.threads);
+
+    if (threads == 1 || str.size() < options.min_parallel_size) {
+      std::vector<value> result;
+      parse_lines(str, str, options.max_depth, [&result](value&& v) { result.push_back(std::move(v)); });
+      return result;
+    }
+
+    const auto batches = split_batches(str, threads * internal::tasks_per_thread);
+    std::vector<std::vector<value>> results(batches.size());
+
+    internal::run_parallel(batches.size(), threads, [&](const std::size_t i) {
+      parse_lines(str, batches[i], options.max_depth, [&results, i](value&& v) { results[i].push_back(std::move(v)); });
+    });
+
+    std::size_t total = 0;
+    for (const auto& r : results) {
+      total += r.size();
+    }
+
+    std::vector<value> result;
+    result.reserve(total);
+    for (auto& r : results) {
+      std::move(r.begin(), r.end(), std::back_inserter(result));
+    }
+    return result;
+  }
+
+  void parse_ndjson(std::string_view str, const std::function<void(value&&)>& callback, const ndjson_options& options) {
+    const auto threads = internal::thread_count(options.threads);
+
+    if (threads == 1 || str.size() < options.min_parallel_size) {
+      parse_lines(str, str, options.max_depth, callback);
+      return;
+    }
+
+    const auto batches = split_batches(str, threads * internal::tasks_per_thread);
+
+    internal::run_parallel(batches.size(), threads, [&](const std::size_t i) {
+      parse_lines(str, batches[i], options.max_depth, callback);
+    });
+  }
+
+  std::vector<value> parse_ndjson_file(const std::filesystem::path& path, const ndjson_options& options) {
+    const internal::mapped_file file(path);
+    return parse_ndjson(file.contents(), options);
+  }
+
+}
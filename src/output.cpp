@@ -0,0 +1,34 @@
+#include "output.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace json::internal {
+
+  void write_fd(const int fd, const char* data, std::size_t size) {
+    while (size != 0) {
+#ifdef _WIN32
+      const auto chunk = static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30));
+      const auto written = ::_write(fd, data, chunk);
+#else
+      const auto written = ::write(fd, data, size);
+#endif
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "Cannot write to file descriptor");
+      }
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+  }
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace json::internal {
+
+  // Appends directly to a string
+  class string_output {
+  public:
+    explicit string_output(std::string& out) : _out(out) {}
+
+    void put(const char c) { _out.push_back(c); }
+    void write(const char* data, const std::size_t size) { _out.append(data, size); }
+    void write(const std::string_view str) { _out.append(str); }
+
+  private:
+    std::string& _out;
+  };
+
+  // Fixed-size buffer handed to a callback whenever it fills up. The buffered tail is
+  // only written by flush(), not by the destructor.
+  class buffered_output {
+  public:
+    static constexpr std::size_t capacity = 64 * 1024;
+
+    using sink = std::function<void(const char*, std::size_t)>;
+
+    explicit buffered_output(sink flush) : _buffer(std::make_unique<char[]>(capacity)), _sink(std::move(flush)) {}
+
+    buffered_output(const buffered_output&) = delete;
+    buffered_output& operator=(const buffered_output&) = delete;
+
+    void put(const char c) {
+      if (_size == capacity) {
+        flush();
+      }
+      _buffer[_size++] = c;
+    }
+
+    void write(const char* data, const std::size_t size) {
+      if (size > capacity - _size) {
+        flush();
+        // Too large to be worth buffering
+        if (size >= capacity) {
+          _sink(data, size);
+          return;
+        }
+      }
+      std::memcpy(_buffer.get() + _size, data, size);
+      _size += size;
+    }
+
+    void write(const std::string_view str) { write(str.data(), str.size()); }
+
+    void flush() {
+      if (_size != 0) {
+        _sink(_buffer.get(), _size);
+        _size = 0;
+      }
+    }
+
+  private:
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _size{};
+    sink _sink;
+  };
+
+  // Writes the whole range to a file descriptor, retrying on partial writes
+  void write_fd(int fd, const char* data, std::size_t size);
+
+}
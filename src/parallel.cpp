@@ -0,0 +1,113 @@
+#include <json/json.hpp>
+#include <json/internal/simd.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+#include "parser.hpp"
+#include "thread_pool.hpp"
+
+namespace json {
+
+  namespace {
+
+    // Offsets of the root array brackets and of the commas between its elements.
+    // Returns false if the root is not a non-empty array or if the brackets do not balance.
+    bool find_top_level_separators(const std::string_view str, std::vector<std::size_t>& separators) {
+      if (str.size() > internal::max_indexed_size) {
+        return false;
+      }
+
+      internal::structural_index index;
+      internal::build_structural_index(str, index);
+      if (index.size() < 3 || str[index[0]] != '[' || str[index[1]] == ']') {
+        return false;
+      }
+
+      std::size_t depth = 0;
+      for (const auto pos : index) {
+        switch (str[pos]) {
+        case '[':
+        case '{':
+          if (++depth == 1) {
+            separators.push_back(pos);
+          }
+          break;
+        case ']':
+        case '}':
+          if (depth == 0) {
+            return false;
+          }
+          if (--depth == 0) {
+            separators.push_back(pos);
+            return true;
+          }
+          break;
+        case ',':
+          if (depth == 1) {
+            separators.push_back(pos);
+          }
+          break;
+        default:
+          break;
+        }
+      }
+
+      return false;
+    }
+
+    // Parses comma separated values, which sit one level below the root array
+    std::vector<value> parse_elements(const std::string_view text, const std::size_t max_depth) {
+      internal::lexer lex(text);
+      std::vector<value> result;
+      while (true) {
+        result.push_back(internal::parser(lex, std::pmr::get_default_resource(), max_depth - 1).parse());
+        if (lex.peek_token() == internal::token_types::eof{}) {
+          break;
+        }
+        lex.require_token<internal::token_types::comma>();
+      }
+      return result;
+    }
+
+  }
+
+  value parse_parallel(std::string_view str, const parallel_options& options) {
+    const auto threads = internal::thread_count(options.threads);
+
+    std::vector<std::size_t> separators;
+    const parse_options sequential{ .max_depth = options.max_depth };
+    if (threads == 1 || str.size() < options.min_parallel_size || options.max_depth == 0 || !find_top_level_separators(str, separators)) {
+      return parse(str, sequential);
+    }
+
+    const std::size_t elements = separators.size() - 1;
+    const std::size_t chunks = std::min(elements, threads * internal::tasks_per_thread);
+    std::vector<std::vector<value>> results(chunks);
+
+    try {
+      internal::run_parallel(chunks, threads, [&](const std::size_t chunk) {
+        const auto first = separators[elements * chunk / chunks];
+        const auto last = separators[elements * (chunk + 1) / chunks];
+        results[chunk] = parse_elements(str.substr(first + 1, last - first - 1), options.max_depth);
+      });
+    }
+    catch (const std::runtime_error&) {
+      // Let the sequential parser report the error with its position in the whole document
+      return parse(str, sequential);
+    }
+
+    std::size_t total = 0;
+    for (const auto& r : results) {
+      total += r.size();
+    }
+
+    array result;
+    result.reserve(total);
+    for (auto& r : results) {
+      std::move(r.begin(), r.end(), std::back_inserter(result));
+    }
+    return result;
+  }
+
+}
@@ -1,107 +1,70 @@
 #include "parser.hpp"
 
-#include <format>
-#include <stack>
+#include <cstring>
+#include <functional>
 
 namespace json::internal {
 
-  enum class parser_state {
-    none,
-    object,
-    array
-  };
-
-  void parser::throw_error(const std::string_view msg) {
-    throw std::runtime_error(std::format("[Parse error at {}:{}]: {}",
-      _lexer.get_current_line(),
-      _lexer.get_current_character(),
-      msg));
+  bool dom_builder::add(value&& v) {
+    if (_stack.empty()) {
+      _result.emplace(std::move(v));
+    }
+    else if (auto arr = _stack.back().get_if<array>(); arr) {
+      arr->push_back(std::move(v));
+    }
+    else {
+      _members.emplace_back(std::move(_keys.back()), std::move(v));
+      _keys.pop_back();
+    }
+    return true;
   }
 
+  bool dom_builder::on_end_object() {
+    const auto first = _members.begin() + static_cast<std::ptrdiff_t>(_object_starts.back());
+    _object_starts.pop_back();
 
-  value parser::parse() {
-
-    parser_state state{ parser_state::none };
-
-    while (_lexer.peek_token() != token_types::eof{}) {
-
-      if (state == parser_state::none) {
-
-        const auto tok = _lexer.next_token();
-
-        if (tok == token_types::open_square{}) {
-          state = parser_state::array;
-        }
-        else if (tok == token_types::open_curly{}) {
-          state = parser_state::object;
-        }
-        else if (tok == token_types::null_value{}) {
-          return null{};
-        }
-        else if (auto str = std::get_if<token_types::string_literal>(&tok); str) {
-          return string{ str->value };
-        }
-        else if(auto bln = std::get_if<token_types::boolean_literal>(&tok); bln) {
-          return boolean{ bln->value };
-        }
-        else if (auto num = std::get_if<token_types::number_literal>(&tok); num) {
-          return number{ num->value };
-        }
-        else {
-          throw_error("Unexpected token");
-        }
-
-      }
-      else if (state == parser_state::array) {
-
-        array array_stack;
-
-        if (_lexer.peek_token() == token_types::close_square{}) {
-          _lexer.next_token(); // Consume close square
-          return array_stack; // Empty array
-        }
-
-        array_stack.push_back(parse());
-        while (_lexer.peek_token() == token_types::comma{}) {
-          _lexer.next_token(); // Consume comma
-          array_stack.push_back(parse());
-        }
-
-        _lexer.require_token<token_types::close_square>();
-
-        return array_stack;
-
-      }
-      else if (state == parser_state::object) {
-
-        object object_stack;
-
-        if (_lexer.peek_token() == token_types::close_curly{}) {
-          _lexer.next_token(); // Consume close curly
-          return object_stack; // Empty object
-        }
-
-        const auto key = _lexer.require_token<token_types::string_literal>();
-        _lexer.require_token<token_types::colon>();
-        object_stack[key.value] = parse();
-
-        while (_lexer.peek_token() == token_types::comma{}) {
-          _lexer.next_token(); // Consume comma
-          const auto key = _lexer.require_token<token_types::string_literal>();
-          _lexer.require_token<token_types::colon>();
-          object_stack[key.value] = parse();
-        }
+    auto& obj = _stack.back().get<object>();
+    obj.reserve(static_cast<std::size_t>(_members.end() - first));
+    for (auto it = first; it != _members.end(); ++it) {
+      obj.insert_or_assign(std::move(it->first), std::move(it->second));
+    }
+    _members.erase(first, _members.end());
 
-        _lexer.require_token<token_types::close_curly>();
+    return end_container();
+  }
 
-        return object_stack;
-      }
+  string dom_builder::borrow(const std::string_view s) {
+    const std::less_equal<const char*> before;
+    if (before(_borrowed_input->data(), s.data()) && before(s.data() + s.size(), _borrowed_input->data() + _borrowed_input->size())) {
+      return string::borrowed(s, _resource);
     }
 
-    throw_error("Unexpected end of input");
+    // Decoded in the lexer's scratch buffer
+    char* copy = static_cast<char*>(_resource->allocate(s.size(), 1));
+    std::memcpy(copy, s.data(), s.size());
+    return string::borrowed({ copy, s.size() }, _resource);
+  }
 
-  };
+  void dom_builder::reset(std::pmr::memory_resource* resource, const std::optional<std::string_view> borrowed_input) {
+    _stack.clear();
+    _keys.clear();
+    _members.clear();
+    _object_starts.clear();
+    _result.reset();
+    _resource = resource;
+    _borrowed_input = borrowed_input;
+  }
 
+  bool dom_builder::end_container() {
+    value container = std::move(_stack.back());
+    _stack.pop_back();
+    return add(std::move(container));
+  }
 
+  value parser::parse() {
+    dom_builder builder(_resource);
+    event_parser<dom_builder>(_lexer, builder, _max_depth).parse();
+    return std::move(builder.result());
+  }
 
-}
\ No newline at end of file
+}
@@ -1,20 +1,75 @@
 #pragma once 
 
 #include <json/json.hpp>
+#include <json/internal/event_parser.hpp>
 
-#include "lexer.hpp"
+#include <optional>
+#include <vector>
 
 namespace json::internal {
 
+  // Builds a json::value from parse events, allocating from the given resource. Strings
+  // that lie in borrowed_input are referenced instead of copied, other strings are then
+  // copied once into the resource and referenced there.
+  class dom_builder {
+  public:
+    dom_builder(std::pmr::memory_resource* resource, std::optional<std::string_view> borrowed_input = std::nullopt) :
+      _resource(resource), _borrowed_input(borrowed_input) {}
+
+    bool on_null() { return add(null{}); }
+    bool on_bool(const bool b) { return add(boolean{ b }); }
+    bool on_number(const double d) { return add(number{ d }); }
+    bool on_string(const std::string_view s) { return add(_borrowed_input ? borrow(s) : string{ s, _resource }); }
+    bool on_key(const std::string_view s) { _keys.emplace_back(s, _resource); return true; }
+    bool on_start_object() { _stack.emplace_back(object(_resource)); _object_starts.push_back(_members.size()); return true; }
+    bool on_end_object();
+    bool on_start_array() { _stack.emplace_back(array(_resource)); return true; }
+    bool on_end_array() { return end_container(); }
+
+    // Drops any partially built value and targets a new resource, the scratch storage
+    // keeps its capacity
+    void reset(std::pmr::memory_resource* resource, std::optional<std::string_view> borrowed_input = std::nullopt);
+
+    [[nodiscard]] value& result() { return *_result; }
+    [[nodiscard]] bool has_result() const { return _result.has_value(); }
+
+    // Moves the finished value out, leaving the builder ready for the next one
+    [[nodiscard]] value take_result() {
+      value result = std::move(*_result);
+      _result.reset();
+      return result;
+    }
+
+  private:
+    std::pmr::memory_resource* _resource;
+    std::optional<std::string_view> _borrowed_input;
+    std::vector<value> _stack;
+    std::vector<std::pmr::string> _keys;
+
+    // Members of the open objects, each object is built once it is complete so that its
+    // storage is allocated at the final size
+    std::vector<std::pair<std::pmr::string, value>> _members;
+    std::vector<std::size_t> _object_starts;
+
+    // Not assigned to: a value moved into an existing container would leave its memory resource
+    std::optional<value> _result;
+
+    bool add(value&& v);
+    string borrow(std::string_view s);
+    bool end_container();
+  };
+
   class parser {
   public:
-    parser(lexer& lex) : _lexer(lex) {}
+    parser(lexer& lex, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const std::size_t max_depth = default_max_depth) :
+      _lexer(lex), _resource(resource), _max_depth(max_depth) {}
 
     value parse();
 
   private:
     lexer& _lexer;
-    void throw_error(const std::string_view msg);
+    std::pmr::memory_resource* _resource;
+    std::size_t _max_depth;
   };
 
-}
\ No newline at end of file
+}
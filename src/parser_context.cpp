@@ -0,0 +1,102 @@
+#include <json/parser_context.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+
+#include "parser.hpp"
+
+namespace json {
+
+  namespace {
+
+    constexpr std::size_t initial_arena_size = 4096;
+
+    // Upstream of the arena. It records how much the arena needed beyond its buffer so
+    // that the buffer can be grown to fit before the next parse.
+    class overflow_resource : public std::pmr::memory_resource {
+    public:
+      std::size_t requested = 0;
+
+    private:
+      void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        requested += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+      }
+
+      void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+      }
+
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+      }
+    };
+
+  }
+
+  struct parser_context::impl {
+
+    parse_options options;
+
+    internal::lexer lex{ std::string_view{} };
+    internal::parse_stack stack;
+    internal::dom_builder builder{ std::pmr::get_default_resource() };
+
+    overflow_resource overflow;
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t buffer_size = 0;
+    std::optional<std::pmr::monotonic_buffer_resource> arena;
+
+    value build(const std::string_view str, std::pmr::memory_resource* resource) {
+      builder.reset(resource);
+      lex.assign(str);
+      internal::event_parser<internal::dom_builder>(lex, builder, options.max_depth, &stack).parse();
+      return builder.take_result();
+    }
+
+    // Makes the whole arena available again. If the last parse overflowed the buffer,
+    // the buffer is replaced by one large enough for it.
+    void recycle_arena() {
+      // Leftovers of a failed parse may point into the arena
+      builder.reset(std::pmr::get_default_resource());
+
+      if (arena && overflow.requested == 0) {
+        arena->release();
+        return;
+      }
+
+      arena.reset();
+      buffer_size = std::bit_ceil(std::max(buffer_size + overflow.requested, initial_arena_size));
+      buffer = std::make_unique_for_overwrite<std::byte[]>(buffer_size);
+      overflow.requested = 0;
+      arena.emplace(buffer.get(), buffer_size, &overflow);
+    }
+  };
+
+  parser_context::parser_context(const parse_options& options) : _impl(std::make_unique<impl>()) {
+    _impl->options = options;
+  }
+
+  parser_context::~parser_context() = default;
+
+  parser_context::parser_context(parser_context&&) noexcept = default;
+  parser_context& parser_context::operator=(parser_context&&) noexcept = default;
+
+  value parser_context::parse(const std::string_view str) {
+    return _impl->build(str, std::pmr::get_default_resource());
+  }
+
+  const value& parser_context::parse_in_arena(const std::string_view str) {
+    _impl->recycle_arena();
+    auto& arena = *_impl->arena;
+    value root = _impl->build(str, &arena);
+    // Like document, the tree is never destroyed: releasing the arena frees it
+    return *new (arena.allocate(sizeof(value), alignof(value))) value(std::move(root));
+  }
+
+  std::size_t parser_context::arena_capacity() const {
+    return _impl->buffer_size;
+  }
+
+}
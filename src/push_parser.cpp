@@ -0,0 +1,287 @@
+#include <json/push_parser.hpp>
+#include <json/internal/simd.hpp>
+
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "parser.hpp"
+
+namespace json {
+
+  namespace {
+
+    bool is_space(const char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool is_number_char(const char c) {
+      return (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E';
+    }
+
+    bool is_literal_char(const char c) {
+      return c >= 'a' && c <= 'z';
+    }
+
+  }
+
+  struct push_parser::impl {
+
+    enum class token_state {
+      none = 0,
+      string_literal,
+      number_literal,
+      literal,
+    };
+
+    // What the grammar accepts next
+    enum class expect {
+      value,
+      value_or_close,
+      key_or_close,
+      key,
+      colon,
+      comma_or_close,
+    };
+
+    internal::dom_builder builder{ std::pmr::get_default_resource() };
+
+    token_state state = token_state::none;
+    bool escape = false;
+
+    // Bytes of a token that started in a previous fragment
+    std::string pending;
+
+    std::vector<char> containers;
+    std::size_t max_depth = default_max_depth;
+    expect next = expect::value;
+
+    std::size_t offset = 0;
+    std::vector<value> completed;
+
+    [[noreturn]] void throw_error(const char* pos, const char* chunk_begin, const std::string_view msg) {
+      throw std::runtime_error(std::format("[Parse error at offset {}]: {}", offset + (pos - chunk_begin), msg));
+    }
+
+    void after_value() {
+      if (containers.empty()) {
+        completed.push_back(builder.take_result());
+        next = expect::value;
+      }
+      else {
+        next = expect::comma_or_close;
+      }
+    }
+
+    void punctuation(const char c, const char* pos, const char* chunk_begin) {
+      switch (c) {
+      case '[':
+      case '{':
+        if (next != expect::value && next != expect::value_or_close) {
+          throw_error(pos, chunk_begin, "Unexpected token");
+        }
+        if (containers.size() >= max_depth) {
+          throw_error(pos, chunk_begin, "Maximum nesting depth exceeded");
+        }
+        containers.push_back(c);
+        if (c == '[') {
+          builder.on_start_array();
+          next = expect::value_or_close;
+        }
+        else {
+          builder.on_start_object();
+          next = expect::key_or_close;
+        }
+        break;
+      case ']':
+      case '}': {
+        const char open = c == ']' ? '[' : '{';
+        const bool can_close = next == expect::comma_or_close || next == (open == '[' ? expect::value_or_close : expect::key_or_close);
+        if (containers.empty() || containers.back() != open || !can_close) {
+          throw_error(pos, chunk_begin, "Unexpected token");
+        }
+        containers.pop_back();
+        if (open == '[') {
+          builder.on_end_array();
+        }
+        else {
+          builder.on_end_object();
+        }
+        after_value();
+        break;
+      }
+      case ',':
+        if (next != expect::comma_or_close) {
+          throw_error(pos, chunk_begin, "Unexpected token");
+        }
+        next = containers.back() == '[' ? expect::value : expect::key;
+        break;
+      case ':':
+        if (next != expect::colon) {
+          throw_error(pos, chunk_begin, "Unexpected token");
+        }
+        next = expect::value;
+        break;
+      default:
+        throw_error(pos, chunk_begin, std::format("Unexpected character {}", c));
+      }
+    }
+
+    // Lexes a complete scalar token with the regular lexer and reports it
+    void scalar(const std::string_view text, const char* pos, const char* chunk_begin) {
+      internal::lexer lex(text);
+      auto tok = lex.next_token();
+      if (lex.next_token() != internal::token_types::eof{}) {
+        throw_error(pos, chunk_begin, "Unexpected token");
+      }
+
+      if (next == expect::key || next == expect::key_or_close) {
+        const auto key = std::get_if<internal::token_types::string_literal>(&tok);
+        if (!key) {
+          throw_error(pos, chunk_begin, "Unexpected token");
+        }
+        builder.on_key(key->value);
+        next = expect::colon;
+        return;
+      }
+
+      if (next != expect::value && next != expect::value_or_close) {
+        throw_error(pos, chunk_begin, "Unexpected token");
+      }
+
+      if (tok == internal::token_types::null_value{}) {
+        builder.on_null();
+      }
+      else if (auto str = std::get_if<internal::token_types::string_literal>(&tok); str) {
+        builder.on_string(str->value);
+      }
+      else if (auto bln = std::get_if<internal::token_types::boolean_literal>(&tok); bln) {
+        builder.on_bool(bln->value);
+      }
+      else if (auto num = std::get_if<internal::token_types::number_literal>(&tok); num) {
+        builder.on_number(num->value);
+      }
+      else {
+        throw_error(pos, chunk_begin, "Unexpected token");
+      }
+
+      after_value();
+    }
+
+    void complete_token(const char* token_start, const char* token_end, const char* chunk_begin) {
+      state = token_state::none;
+      if (pending.empty()) {
+        scalar(std::string_view(token_start, static_cast<std::size_t>(token_end - token_start)), token_start, chunk_begin);
+      }
+      else {
+        pending.append(token_start, token_end);
+        scalar(pending, token_start, chunk_begin);
+        pending.clear();
+      }
+    }
+
+    void feed(const char* p, const char* end) {
+      const char* const chunk_begin = p;
+      const char* token_start = p;
+
+      while (p != end) {
+
+        if (state == token_state::none) {
+
+          while (p != end && is_space(*p))
+            ++p;
+
+          if (p == end) {
+            break;
+          }
+
+          token_start = p;
+          const char ch = *p++;
+
+          if (ch == '"') {
+            state = token_state::string_literal;
+            escape = false;
+          }
+          else if (is_literal_char(ch)) {
+            state = token_state::literal;
+          }
+          else if (is_number_char(ch)) {
+            state = token_state::number_literal;
+          }
+          else {
+            punctuation(ch, token_start, chunk_begin);
+          }
+        }
+        else if (state == token_state::string_literal) {
+
+          if (escape) {
+            escape = false;
+            ++p;
+            continue;
+          }
+
+          p = internal::find_quote_or_backslash(p, end);
+          if (p == end) {
+            break;
+          }
+
+          if (*p++ == '\\') {
+            escape = true;
+          }
+          else {
+            complete_token(token_start, p, chunk_begin);
+          }
+        }
+        else {
+          const auto accepts = state == token_state::number_literal ? is_number_char : is_literal_char;
+          while (p != end && accepts(*p))
+            ++p;
+
+          if (p != end) {
+            complete_token(token_start, p, chunk_begin);
+          }
+        }
+      }
+
+      // Keep the beginning of a token that continues in the next fragment
+      if (state != token_state::none) {
+        pending.append(token_start, end);
+      }
+
+      offset += static_cast<std::size_t>(end - chunk_begin);
+    }
+  };
+
+  push_parser::push_parser(const parse_options& options) : _impl(std::make_unique<impl>()) {
+    _impl->max_depth = options.max_depth;
+  }
+  push_parser::~push_parser() = default;
+
+  push_parser::push_parser(push_parser&&) noexcept = default;
+  push_parser& push_parser::operator=(push_parser&&) noexcept = default;
+
+  std::vector<value> push_parser::feed(std::span<const char> chunk) {
+    _impl->feed(chunk.data(), chunk.data() + chunk.size());
+    return std::exchange(_impl->completed, {});
+  }
+
+  std::vector<value> push_parser::finish() {
+    // Numbers and literals are only terminated by the following character
+    if (_impl->state == impl::token_state::number_literal || _impl->state == impl::token_state::literal) {
+      const std::string token = std::exchange(_impl->pending, {});
+      _impl->complete_token(token.data(), token.data() + token.size(), token.data());
+    }
+
+    if (!idle()) {
+      throw std::runtime_error(std::format("[Parse error at offset {}]: Unexpected end of input", _impl->offset));
+    }
+
+    return std::exchange(_impl->completed, {});
+  }
+
+  bool push_parser::idle() const {
+    return _impl->state == impl::token_state::none && _impl->containers.empty() && _impl->next == impl::expect::value;
+  }
+
+}
@@ -0,0 +1,200 @@
+#include <json/query.hpp>
+#include <json/lazy.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+
+#include "parser.hpp"
+
+namespace json {
+
+  namespace {
+
+    using internal::lazy_kind;
+    using internal::lazy_ref;
+    using internal::query_node;
+
+    bool is_space(const char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    const char* skip_whitespace(const char* p, const char* end) {
+      while (p != end && is_space(*p))
+        ++p;
+      return p;
+    }
+
+    // Walks the document once, descending only into the subtrees the pointers go through
+    class evaluator {
+    public:
+      evaluator(const std::vector<query_node>& nodes, std::vector<std::vector<value>>& results, const std::size_t max_depth) :
+        _nodes(nodes), _results(results), _max_depth(max_depth) {}
+
+      // Returns the first character after the value
+      const char* walk(const lazy_ref& ref, const std::size_t index) {
+        const auto& node = _nodes[index];
+
+        const char* end = nullptr;
+        if (!node.targets.empty()) {
+          end = materialize(ref, node.targets);
+        }
+
+        if (node.children.empty() && node.wildcard == query_node::none) {
+          return end ? end : ref.skip();
+        }
+
+        switch (ref.kind()) {
+        case lazy_kind::array: return walk_array(ref, node);
+        case lazy_kind::object: return walk_object(ref, node);
+        default: return end ? end : ref.skip();
+        }
+      }
+
+    private:
+      const std::vector<query_node>& _nodes;
+      std::vector<std::vector<value>>& _results;
+      std::size_t _max_depth;
+      // Containers entered on the way to the current value, they count towards the limit
+      std::size_t _depth = 0;
+
+      // Parses the value with the regular parser, positioned in the whole document so that
+      // error positions are absolute
+      const char* materialize(const lazy_ref& ref, const std::vector<std::size_t>& targets) {
+        internal::lexer lex(std::string_view(ref.begin, static_cast<std::size_t>(ref.end - ref.begin)));
+        lex.reset({ .offset = static_cast<std::size_t>(ref.cur - ref.begin) });
+        internal::dom_builder builder(std::pmr::get_default_resource());
+        internal::event_parser<internal::dom_builder>(lex, builder, _max_depth - std::min(_depth, _max_depth)).parse();
+
+        for (std::size_t i = 0; i + 1 < targets.size(); ++i) {
+          _results[targets[i]].push_back(builder.result());
+        }
+        _results[targets.back()].push_back(builder.take_result());
+        return ref.begin + lex.mark().offset;
+      }
+
+      // Visits the child with every node it matches, the exact token first
+      template<typename Matches>
+      const char* visit(const lazy_ref& child, const query_node& node, Matches&& matches) {
+        const char* end = nullptr;
+        for (const auto& [token, next] : node.children) {
+          if (matches(token)) {
+            end = walk(child, next);
+            break;
+          }
+        }
+        if (node.wildcard != query_node::none) {
+          end = walk(child, node.wildcard);
+        }
+        return end ? end : child.skip();
+      }
+
+      const char* walk_array(const lazy_ref& ref, const query_node& node) {
+        ++_depth;
+        const char* pos = ref.cur + 1;
+        std::size_t index = 0;
+        for (const char* p = ref.first_child(); p; p = ref.next_child(pos), ++index) {
+          char digits[24];
+          const auto length = static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), index).ptr - digits);
+          pos = visit({ ref.begin, p, ref.end }, node, [&](const std::string_view token) {
+            return token == std::string_view(digits, length);
+          });
+        }
+        --_depth;
+        return skip_whitespace(pos, ref.end) + 1;
+      }
+
+      const char* walk_object(const lazy_ref& ref, const query_node& node) {
+        ++_depth;
+        const char* pos = ref.cur + 1;
+        for (const char* p = ref.first_child(); p; p = ref.next_child(pos)) {
+          const auto [raw_key, val] = lazy_ref{ ref.begin, p, ref.end }.member();
+          if (raw_key.find('\\') == std::string_view::npos) {
+            pos = visit(val, node, [&](const std::string_view token) { return token == raw_key; });
+          }
+          else {
+            const auto key = lazy_ref{ ref.begin, p, ref.end }.read_string();
+            pos = visit(val, node, [&](const std::string_view token) { return token == key; });
+          }
+        }
+        --_depth;
+        return skip_whitespace(pos, ref.end) + 1;
+      }
+    };
+
+  }
+
+  query::query(std::initializer_list<std::string_view> pointers) : _nodes(1) {
+    for (const auto pointer : pointers) {
+      add(pointer);
+    }
+  }
+
+  query::query(const std::vector<std::string>& pointers) : _nodes(1) {
+    for (const auto& pointer : pointers) {
+      add(pointer);
+    }
+  }
+
+  void query::add(const std::string_view pointer) {
+    if (!pointer.empty() && pointer.front() != '/') {
+      throw std::runtime_error(std::format("Invalid JSON pointer {}", pointer));
+    }
+
+    std::size_t node = 0;
+    std::size_t start = 0;
+    while (start < pointer.size()) {
+      // Reference tokens follow each '/', ~1 and ~0 stand for '/' and '~'
+      const auto end = std::min(pointer.find('/', start + 1), pointer.size());
+      std::string token;
+      for (auto i = start + 1; i < end; ++i) {
+        if (pointer[i] != '~') {
+          token += pointer[i];
+        }
+        else if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1')) {
+          token += pointer[++i] == '0' ? '~' : '/';
+        }
+        else {
+          throw std::runtime_error(std::format("Invalid JSON pointer {}", pointer));
+        }
+      }
+      start = end;
+
+      std::size_t next = query_node::none;
+      if (token == "*") {
+        next = _nodes[node].wildcard;
+        if (next == query_node::none) {
+          next = _nodes[node].wildcard = _nodes.size();
+          _nodes.emplace_back();
+        }
+      }
+      else {
+        for (const auto& [child_token, child] : _nodes[node].children) {
+          if (child_token == token) {
+            next = child;
+            break;
+          }
+        }
+        if (next == query_node::none) {
+          next = _nodes.size();
+          _nodes[node].children.emplace_back(std::move(token), next);
+          _nodes.emplace_back();
+        }
+      }
+      node = next;
+    }
+
+    _nodes[node].targets.push_back(_count++);
+  }
+
+  std::vector<std::vector<value>> query::select(const std::string_view str, const parse_options& options) const {
+    std::vector<std::vector<value>> results(_count);
+
+    const lazy_ref root{ str.data(), skip_whitespace(str.data(), str.data() + str.size()), str.data() + str.size() };
+    evaluator(_nodes, results, options.max_depth).walk(root, 0);
+
+    return results;
+  }
+
+}
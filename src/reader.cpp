@@ -0,0 +1,157 @@
+#include <json/reader.hpp>
+
+#include <format>
+#include <stdexcept>
+
+#include "parser.hpp"
+
+namespace json {
+
+  namespace {
+
+    // Accepts every event, the parser still validates what it skips
+    struct skipper {
+      bool on_null() { return true; }
+      bool on_bool(bool) { return true; }
+      bool on_number(double) { return true; }
+      bool on_string(std::string_view) { return true; }
+      bool on_key(std::string_view) { return true; }
+      bool on_start_object() { return true; }
+      bool on_end_object() { return true; }
+      bool on_start_array() { return true; }
+      bool on_end_array() { return true; }
+    };
+
+  }
+
+  struct reader::impl {
+
+    internal::lexer lex;
+    std::size_t max_depth;
+
+    // One entry per open container, set once its first element or member is read
+    std::vector<char> open;
+
+    impl(const std::string_view str, const std::size_t max_depth) : lex(str), max_depth(max_depth) {}
+
+    [[noreturn]] void throw_error(const std::string_view msg) {
+      throw std::runtime_error(std::format("[Parse error at {}:{}]: {}",
+        lex.get_current_line(),
+        lex.get_current_character(),
+        msg));
+    }
+
+    void push() {
+      if (open.size() >= max_depth) {
+        throw_error("Maximum nesting depth exceeded");
+      }
+      open.push_back(false);
+    }
+
+    // Consumes either the closing token, returning false, or the comma that precedes
+    // every element but the first
+    template<typename Close>
+    bool next() {
+      if (open.empty()) {
+        throw_error("Not in a container");
+      }
+      if (std::holds_alternative<Close>(lex.peek_token())) {
+        lex.next_token();
+        open.pop_back();
+        return false;
+      }
+      if (open.back()) {
+        lex.require_token<internal::token_types::comma>();
+      }
+      open.back() = true;
+      return true;
+    }
+  };
+
+  reader::reader(const std::string_view str, const parse_options& options) :
+    _impl(std::make_unique<impl>(str, options.max_depth)) {}
+
+  reader::~reader() = default;
+
+  reader::reader(reader&&) noexcept = default;
+  reader& reader::operator=(reader&&) noexcept = default;
+
+  reader::kind reader::peek() {
+    const auto& tok = _impl->lex.peek_token();
+    if (tok == internal::token_types::null_value{}) {
+      return kind::null;
+    }
+    else if (std::holds_alternative<internal::token_types::boolean_literal>(tok)) {
+      return kind::boolean;
+    }
+    else if (std::holds_alternative<internal::token_types::number_literal>(tok)) {
+      return kind::number;
+    }
+    else if (std::holds_alternative<internal::token_types::string_literal>(tok)) {
+      return kind::string;
+    }
+    else if (tok == internal::token_types::open_square{}) {
+      return kind::array;
+    }
+    else if (tok == internal::token_types::open_curly{}) {
+      return kind::object;
+    }
+    else if (tok == internal::token_types::eof{}) {
+      _impl->throw_error("Unexpected end of input");
+    }
+    else {
+      _impl->throw_error("Unexpected token");
+    }
+  }
+
+  void reader::read_null() {
+    _impl->lex.require_token<internal::token_types::null_value>();
+  }
+
+  bool reader::read_bool() {
+    return _impl->lex.require_token<internal::token_types::boolean_literal>().value;
+  }
+
+  double reader::read_number() {
+    return _impl->lex.require_token<internal::token_types::number_literal>().value;
+  }
+
+  std::string_view reader::read_string() {
+    return _impl->lex.require_token<internal::token_types::string_literal>().value;
+  }
+
+  value reader::read_value() {
+    internal::dom_builder builder(std::pmr::get_default_resource());
+    internal::event_parser<internal::dom_builder>(_impl->lex, builder, _impl->max_depth - _impl->open.size()).parse();
+    return builder.take_result();
+  }
+
+  void reader::skip() {
+    skipper handler;
+    internal::event_parser<skipper>(_impl->lex, handler, _impl->max_depth - _impl->open.size()).parse();
+  }
+
+  void reader::begin_array() {
+    _impl->lex.require_token<internal::token_types::open_square>();
+    _impl->push();
+  }
+
+  bool reader::next_element() {
+    return _impl->next<internal::token_types::close_square>();
+  }
+
+  void reader::begin_object() {
+    _impl->lex.require_token<internal::token_types::open_curly>();
+    _impl->push();
+  }
+
+  std::optional<std::string_view> reader::next_key() {
+    if (!_impl->next<internal::token_types::close_curly>()) {
+      return std::nullopt;
+    }
+    const auto key = _impl->lex.require_token<internal::token_types::string_literal>();
+    _impl->lex.require_token<internal::token_types::colon>();
+    return key.value;
+  }
+
+}
@@ -0,0 +1,10 @@
+#include <json/sax.hpp>
+
+namespace json {
+
+  bool parse_sax(std::string_view str, sax_handler_interface& handler) {
+    internal::lexer lex(str);
+    return internal::event_parser<sax_handler_interface>(lex, handler).parse();
+  }
+
+}
@@ -0,0 +1,387 @@
+#include <json/internal/simd.hpp>
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JSON_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define JSON_TARGET_AVX2
+#else
+#define JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace json::internal {
+
+  namespace {
+
+    // One bit per byte of a 64 byte block
+    struct block_masks {
+      std::uint64_t quote{};
+      std::uint64_t backslash{};
+      std::uint64_t whitespace{};
+      std::uint64_t op{};
+    };
+
+    // Carried from one block to the next
+    struct index_state {
+      std::uint64_t escape_carry{};
+      std::uint64_t in_string{};
+      std::uint64_t scalar_carry{};
+    };
+
+    bool is_op(const char c) {
+      switch (c) {
+      case '{': case '}': case '[': case ']': case '(': case ')': case ',': case ':': return true;
+      default: return false;
+      }
+    }
+
+    bool is_space(const char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    block_masks classify_scalar(const char* p) {
+      block_masks result;
+      for (std::size_t i = 0; i < 64; ++i) {
+        const std::uint64_t bit = std::uint64_t{ 1 } << i;
+        const char c = p[i];
+        if (c == '"') result.quote |= bit;
+        else if (c == '\\') result.backslash |= bit;
+        else if (is_space(c)) result.whitespace |= bit;
+        else if (is_op(c)) result.op |= bit;
+      }
+      return result;
+    }
+
+#if JSON_SIMD_X86
+
+    std::uint64_t movemask(const __m128i m) {
+      return static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+    }
+
+    __m128i eq(const __m128i v, const char c) {
+      return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+    }
+
+    block_masks classify_sse2(const char* p) {
+      block_masks result;
+      for (std::size_t i = 0; i < 4; ++i) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+
+        const __m128i ws = _mm_or_si128(_mm_or_si128(eq(v, ' '), eq(v, '\n')), _mm_or_si128(eq(v, '\r'), eq(v, '\t')));
+        const __m128i op = _mm_or_si128(
+          _mm_or_si128(_mm_or_si128(eq(v, '{'), eq(v, '}')), _mm_or_si128(eq(v, '['), eq(v, ']'))),
+          _mm_or_si128(_mm_or_si128(eq(v, '('), eq(v, ')')), _mm_or_si128(eq(v, ','), eq(v, ':'))));
+
+        result.quote |= movemask(eq(v, '"')) << (i * 16);
+        result.backslash |= movemask(eq(v, '\\')) << (i * 16);
+        result.whitespace |= movemask(ws) << (i * 16);
+        result.op |= movemask(op) << (i * 16);
+      }
+      return result;
+    }
+
+    JSON_TARGET_AVX2 std::uint64_t movemask(const __m256i m) {
+      return static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+    }
+
+    JSON_TARGET_AVX2 __m256i eq(const __m256i v, const char c) {
+      return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+    }
+
+    JSON_TARGET_AVX2 block_masks classify_avx2(const char* p) {
+      block_masks result;
+      for (std::size_t i = 0; i < 2; ++i) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * 32));
+
+        const __m256i ws = _mm256_or_si256(_mm256_or_si256(eq(v, ' '), eq(v, '\n')), _mm256_or_si256(eq(v, '\r'), eq(v, '\t')));
+        const __m256i op = _mm256_or_si256(
+          _mm256_or_si256(_mm256_or_si256(eq(v, '{'), eq(v, '}')), _mm256_or_si256(eq(v, '['), eq(v, ']'))),
+          _mm256_or_si256(_mm256_or_si256(eq(v, '('), eq(v, ')')), _mm256_or_si256(eq(v, ','), eq(v, ':'))));
+
+        result.quote |= movemask(eq(v, '"')) << (i * 32);
+        result.backslash |= movemask(eq(v, '\\')) << (i * 32);
+        result.whitespace |= movemask(ws) << (i * 32);
+        result.op |= movemask(op) << (i * 32);
+      }
+      return result;
+    }
+
+#endif
+
+    // Bits of the characters preceded by an unescaped backslash
+    std::uint64_t find_escaped(std::uint64_t backslash, index_state& state) {
+      std::uint64_t escaped = state.escape_carry;
+      backslash &= ~escaped;
+      state.escape_carry = 0;
+
+      while (backslash) {
+        const int i = std::countr_zero(backslash);
+        if (i == 63) {
+          state.escape_carry = 1;
+        }
+        else {
+          escaped |= std::uint64_t{ 1 } << (i + 1);
+          backslash &= ~(std::uint64_t{ 1 } << (i + 1));
+        }
+        backslash &= backslash - 1;
+      }
+
+      return escaped;
+    }
+
+    std::uint64_t prefix_xor(std::uint64_t x) {
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      return x;
+    }
+
+    std::uint32_t* index_block(const block_masks& m, index_state& state, const std::uint32_t base, std::uint32_t* out) {
+      const std::uint64_t quote = m.quote & ~find_escaped(m.backslash, state);
+
+      // Opening quote and string contents, closing quote excluded
+      const std::uint64_t in_string = prefix_xor(quote) ^ state.in_string;
+      state.in_string = static_cast<std::uint64_t>(static_cast<std::int64_t>(in_string) >> 63);
+
+      const std::uint64_t scalar = ~(m.op | m.whitespace);
+      const std::uint64_t nonquote_scalar = scalar & ~quote;
+      const std::uint64_t follows_scalar = (nonquote_scalar << 1) | state.scalar_carry;
+      state.scalar_carry = nonquote_scalar >> 63;
+
+      // String contents and closing quote
+      const std::uint64_t string_tail = in_string ^ quote;
+
+      std::uint64_t structurals = (m.op | quote | (scalar & ~follows_scalar)) & ~string_tail;
+
+      while (structurals) {
+        *out++ = base + static_cast<std::uint32_t>(std::countr_zero(structurals));
+        structurals &= structurals - 1;
+      }
+
+      return out;
+    }
+
+    // Grows the index so that a whole block of token starts always fits
+    class index_writer {
+    public:
+      index_writer(structural_index& out, const std::size_t input_size) : _out(out) {
+        _out.resize(input_size / 8 + 64);
+      }
+
+      std::uint32_t* reserve_block() {
+        if (_out.size() - _count < 64) {
+          _out.resize(_out.size() * 2);
+        }
+        return _out.data() + _count;
+      }
+
+      void commit(const std::uint32_t* end) { _count = end - _out.data(); }
+      void finish() { _out.resize(_count); }
+
+    private:
+      structural_index& _out;
+      std::size_t _count{};
+    };
+
+    template<typename Classify>
+    void index_blocks(std::string_view in, index_state& state, index_writer& out, Classify classify) {
+      const std::size_t full = in.size() & ~std::size_t{ 63 };
+      for (std::size_t i = 0; i < full; i += 64) {
+        out.commit(index_block(classify(in.data() + i), state, static_cast<std::uint32_t>(i), out.reserve_block()));
+      }
+    }
+
+    void index_scalar(std::string_view in, index_state& state, index_writer& out) {
+      index_blocks(in, state, out, classify_scalar);
+    }
+
+#if JSON_SIMD_X86
+
+    void index_sse2(std::string_view in, index_state& state, index_writer& out) {
+      index_blocks(in, state, out, classify_sse2);
+    }
+
+    JSON_TARGET_AVX2 void index_avx2(std::string_view in, index_state& state, index_writer& out) {
+      const std::size_t full = in.size() & ~std::size_t{ 63 };
+      for (std::size_t i = 0; i < full; i += 64) {
+        out.commit(index_block(classify_avx2(in.data() + i), state, static_cast<std::uint32_t>(i), out.reserve_block()));
+      }
+    }
+
+#endif
+
+    const char* find_scalar(const char* begin, const char* end) {
+      while (begin != end && *begin != '"' && *begin != '\\')
+        ++begin;
+      return begin;
+    }
+
+    bool needs_escape(const char c) {
+      return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    }
+
+    const char* find_escape_scalar(const char* begin, const char* end) {
+      while (begin != end && !needs_escape(*begin))
+        ++begin;
+      return begin;
+    }
+
+#if JSON_SIMD_X86
+
+    const char* find_sse2(const char* begin, const char* end) {
+      const __m128i quote = _mm_set1_epi8('"');
+      const __m128i backslash = _mm_set1_epi8('\\');
+      for (; end - begin >= 16; begin += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        if (mask) {
+          return begin + std::countr_zero(static_cast<unsigned>(mask));
+        }
+      }
+      return find_scalar(begin, end);
+    }
+
+    JSON_TARGET_AVX2 const char* find_avx2(const char* begin, const char* end) {
+      const __m256i quote = _mm256_set1_epi8('"');
+      const __m256i backslash = _mm256_set1_epi8('\\');
+      for (; end - begin >= 32; begin += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        const int mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)));
+        if (mask) {
+          return begin + std::countr_zero(static_cast<unsigned>(mask));
+        }
+      }
+      return find_sse2(begin, end);
+    }
+
+    // Control characters are found with an unsigned max: x <= 0x1F iff max(x, 0x1F) == 0x1F
+    const char* find_escape_sse2(const char* begin, const char* end) {
+      const __m128i quote = _mm_set1_epi8('"');
+      const __m128i backslash = _mm_set1_epi8('\\');
+      const __m128i control = _mm_set1_epi8(0x1F);
+      for (; end - begin >= 16; begin += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(v, control), control)));
+        if (mask) {
+          return begin + std::countr_zero(static_cast<unsigned>(mask));
+        }
+      }
+      return find_escape_scalar(begin, end);
+    }
+
+    JSON_TARGET_AVX2 const char* find_escape_avx2(const char* begin, const char* end) {
+      const __m256i quote = _mm256_set1_epi8('"');
+      const __m256i backslash = _mm256_set1_epi8('\\');
+      const __m256i control = _mm256_set1_epi8(0x1F);
+      for (; end - begin >= 32; begin += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+        const int mask = _mm256_movemask_epi8(_mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control)));
+        if (mask) {
+          return begin + std::countr_zero(static_cast<unsigned>(mask));
+        }
+      }
+      return find_escape_sse2(begin, end);
+    }
+
+#endif
+
+  }
+
+  simd_level detected_simd_level() {
+    static const simd_level level = [] {
+#if JSON_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 1);
+      const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+      __cpuidex(info, 7, 0);
+      if (os_saves_ymm && (info[1] & (1 << 5))) {
+        return simd_level::avx2;
+      }
+#else
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) {
+        return simd_level::avx2;
+      }
+#endif
+      return simd_level::sse2;
+#else
+      return simd_level::scalar;
+#endif
+    }();
+    return level;
+  }
+
+  void build_structural_index(std::string_view in, structural_index& out) {
+    build_structural_index(in, out, detected_simd_level());
+  }
+
+  void build_structural_index(std::string_view in, structural_index& out, const simd_level level) {
+    index_state state;
+    index_writer writer(out, in.size());
+
+#if JSON_SIMD_X86
+    switch (level) {
+    case simd_level::avx2: index_avx2(in, state, writer); break;
+    case simd_level::sse2: index_sse2(in, state, writer); break;
+    default: index_scalar(in, state, writer); break;
+    }
+#else
+    index_scalar(in, state, writer);
+#endif
+
+    // Pad the last partial block with spaces, they never produce token starts
+    const std::size_t full = in.size() & ~std::size_t{ 63 };
+    if (full != in.size()) {
+      char tail[64];
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, in.data() + full, in.size() - full);
+      writer.commit(index_block(classify_scalar(tail), state, static_cast<std::uint32_t>(full), writer.reserve_block()));
+    }
+
+    writer.finish();
+  }
+
+  const char* find_quote_or_backslash(const char* begin, const char* end) {
+    return find_quote_or_backslash(begin, end, detected_simd_level());
+  }
+
+  const char* find_quote_or_backslash(const char* begin, const char* end, const simd_level level) {
+#if JSON_SIMD_X86
+    switch (level) {
+    case simd_level::avx2: return find_avx2(begin, end);
+    case simd_level::sse2: return find_sse2(begin, end);
+    default: return find_scalar(begin, end);
+    }
+#else
+    return find_scalar(begin, end);
+#endif
+  }
+
+  const char* find_escape(const char* begin, const char* end) {
+    return find_escape(begin, end, detected_simd_level());
+  }
+
+  const char* find_escape(const char* begin, const char* end, const simd_level level) {
+#if JSON_SIMD_X86
+    switch (level) {
+    case simd_level::avx2: return find_escape_avx2(begin, end);
+    case simd_level::sse2: return find_escape_sse2(begin, end);
+    default: return find_escape_scalar(begin, end);
+    }
+#else
+    return find_escape_scalar(begin, end);
+#endif
+  }
+
+}
@@ -0,0 +1,164 @@
+#include <json/tape.hpp>
+
+#include <algorithm>
+
+#include "parser.hpp"
+
+namespace json {
+
+  namespace {
+
+    using internal::tape_type;
+    using internal::make_tape_entry;
+
+    // Writes parse events to a tape
+    class tape_builder {
+    public:
+      // Keys are interned into the table when one is given
+      tape_builder(std::vector<std::uint64_t>& tape, std::vector<char>& strings, internal::tape_key_table* keys) :
+        _tape(tape), _strings(strings), _keys(keys) {}
+
+      bool on_null() { element(); _tape.push_back(make_tape_entry(tape_type::null, 0)); return true; }
+      bool on_bool(const bool b) { element(); _tape.push_back(make_tape_entry(b ? tape_type::true_value : tape_type::false_value, 0)); return true; }
+
+      bool on_number(const double d) {
+        element();
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        _tape.push_back(make_tape_entry(tape_type::number, 0));
+        _tape.push_back(bits);
+        return true;
+      }
+
+      bool on_string(const std::string_view s) { element(); write_string(s); return true; }
+      bool on_key(const std::string_view s) {
+        ++_open.back().count;
+        if (_keys) {
+          write_key(s);
+        }
+        else {
+          write_string(s);
+        }
+        return true;
+      }
+
+      bool on_start_object() { return begin_container(true); }
+      bool on_end_object() { return end_container(tape_type::start_object, tape_type::end_object); }
+      bool on_start_array() { return begin_container(false); }
+      bool on_end_array() { return end_container(tape_type::start_array, tape_type::end_array); }
+
+    private:
+      struct open_container {
+        std::size_t start{};
+        std::size_t count{};
+        bool is_object{};
+      };
+
+      std::vector<std::uint64_t>& _tape;
+      std::vector<char>& _strings;
+      internal::tape_key_table* _keys;
+      std::vector<open_container> _open;
+      std::vector<std::size_t> _offsets; // Indexed by key id
+
+      // Object members are counted by their keys
+      void element() {
+        if (!_open.empty() && !_open.back().is_object) {
+          ++_open.back().count;
+        }
+      }
+
+      bool begin_container(const bool is_object) {
+        element();
+        _open.push_back({ .start = _tape.size(), .count = 0, .is_object = is_object });
+        _tape.push_back(0); // Patched once the container ends
+        return true;
+      }
+
+      bool end_container(const tape_type start_type, const tape_type end_type) {
+        const auto [start, count, is_object] = _open.back();
+        _open.pop_back();
+
+        const auto end = _tape.size();
+        if (end > internal::tape_index_mask) {
+          throw std::runtime_error("Document too large");
+        }
+        _tape.push_back(make_tape_entry(end_type, start));
+        _tape[start] = make_tape_entry(start_type, (std::min<std::uint64_t>(count, internal::tape_max_count) << 32) | end);
+        return true;
+      }
+
+      std::size_t append_string(const std::string_view str) {
+        if (str.size() > UINT32_MAX) {
+          throw std::runtime_error("String too large");
+        }
+        const auto length = static_cast<std::uint32_t>(str.size());
+        const auto offset = _strings.size();
+        _strings.resize(offset + sizeof(length) + str.size());
+        std::memcpy(_strings.data() + offset, &length, sizeof(length));
+        std::memcpy(_strings.data() + offset + sizeof(length), str.data(), str.size());
+        return offset;
+      }
+
+      void write_string(const std::string_view str) {
+        _tape.push_back(make_tape_entry(tape_type::string, append_string(str)));
+      }
+
+      // The key bytes are stored once, at their first occurrence. Once the table or the
+      // string buffer outgrows the entry layout, new keys are stored as plain strings.
+      void write_key(const std::string_view str) {
+        auto it = _keys->find(str);
+        if (it == _keys->end()) {
+          if (_keys->size() > internal::tape_max_key_id || _strings.size() > internal::tape_index_mask) {
+            write_string(str);
+            return;
+          }
+          it = _keys->emplace(str, static_cast<std::uint32_t>(_keys->size())).first;
+          _offsets.push_back(append_string(str));
+        }
+        _tape.push_back(make_tape_entry(tape_type::key, (std::uint64_t{ it->second } << 32) | _offsets[it->second]));
+      }
+    };
+
+  }
+
+  tape_document::tape_document(std::string_view str, const tape_options& options) {
+    // Rough estimates from the input size, both grow as needed
+    _tape.reserve(str.size() / 4 + 2);
+    _strings.reserve(str.size() / 2);
+
+    internal::lexer lex(str);
+    tape_builder builder(_tape, _strings, options.intern_keys ? &_keys : nullptr);
+    internal::event_parser<tape_builder>(lex, builder, options.max_depth).parse();
+  }
+
+  value value_view::to_value() const {
+    if (is<null>()) {
+      return get<null>();
+    }
+    else if (is<boolean>()) {
+      return get<boolean>();
+    }
+    else if (is<number>()) {
+      return get<number>();
+    }
+    else if (is<string>()) {
+      return string{ get<string>() };
+    }
+    else if (is<array>()) {
+      array result;
+      result.reserve(size());
+      for (const auto el : get<array>()) {
+        result.push_back(el.to_value());
+      }
+      return result;
+    }
+    else {
+      object result;
+      for (const auto [key, val] : get<object>()) {
+        result.insert_or_assign(std::pmr::string(key), val.to_value());
+      }
+      return result;
+    }
+  }
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace json::internal {
+
+  // Requested thread count, 0 meaning every hardware thread
+  inline std::size_t thread_count(const std::size_t requested) {
+    const std::size_t threads = requested ? requested : std::thread::hardware_concurrency();
+    return std::max<std::size_t>(threads, 1);
+  }
+
+  // Runs task(i) for every i in [0, count) on a pool of threads, the calling thread included.
+  // The first exception stops the remaining tasks and is rethrown.
+  template<typename F>
+  void run_parallel(const std::size_t count, const std::size_t threads, F&& task) {
+    std::atomic<std::size_t> next{ 0 };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto worker = [&]() {
+      for (std::size_t i = next++; i < count; i = next++) {
+        try {
+          task(i);
+        }
+        catch (...) {
+          std::lock_guard lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          next = count;
+        }
+      }
+    };
+
+    std::vector<std::thread> pool;
+    const std::size_t pool_size = std::min(threads, count);
+    try {
+      pool.reserve(pool_size);
+      for (std::size_t i = 1; i < pool_size; ++i) {
+        pool.emplace_back(worker);
+      }
+    }
+    catch (...) {
+      // The started threads refer to this frame: stop them before unwinding it
+      next = count;
+      for (auto& t : pool) {
+        t.join();
+      }
+      throw;
+    }
+    worker();
+    for (auto& t : pool) {
+      t.join();
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // A few tasks per thread keep the workers busy when the pieces have uneven costs
+  constexpr std::size_t tasks_per_thread = 4;
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <json/json.hpp>
+#include <json/internal/simd.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace json::internal {
+
+  // Clean runs are located with the simd scan and copied in one go
+  template<typename Output>
+  void write_string(Output& out, const std::string_view str) {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    out.put('"');
+    const char* p = str.data();
+    const char* const end = p + str.size();
+    while (true) {
+      const char* run_end = internal::find_escape(p, end);
+      out.write(p, static_cast<std::size_t>(run_end - p));
+      if (run_end == end) {
+        break;
+      }
+
+      const char c = *run_end;
+      switch (c) {
+      case '"': out.write("\\\""); break;
+      case '\\': out.write("\\\\"); break;
+      case '\b': out.write("\\b"); break;
+      case '\f': out.write("\\f"); break;
+      case '\n': out.write("\\n"); break;
+      case '\r': out.write("\\r"); break;
+      case '\t': out.write("\\t"); break;
+      default: {
+        const char escaped[] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF] };
+        out.write(escaped, sizeof(escaped));
+        break;
+      }
+      }
+      p = run_end + 1;
+    }
+    out.put('"');
+  }
+
+  // Shortest representation that parses back to the same double. NaN and infinities
+  // have no JSON representation and are written as null.
+  template<typename Output>
+  void write_number(Output& out, const double d) {
+    if (!std::isfinite(d)) {
+      out.write("null");
+      return;
+    }
+
+    char buffer[32];
+    std::to_chars_result result;
+
+    // Whole values are printed as integers, without going through the shortest search
+    if (d == std::trunc(d) && std::abs(d) < 0x1p63 && !(d == 0 && std::signbit(d))) {
+      result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int64_t>(d));
+    }
+    else {
+      result = std::to_chars(buffer, buffer + sizeof(buffer), d);
+    }
+    out.write(buffer, static_cast<std::size_t>(result.ptr - buffer));
+  }
+
+  template<typename Output, typename T>
+    requires std::is_integral_v<T>
+  void write_integer(Output& out, const T i) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), i);
+    out.write(buffer, static_cast<std::size_t>(result.ptr - buffer));
+  }
+
+  // Serializes depth-first straight into the output, without intermediate strings. Open
+  // containers are kept on an explicit stack, so deep trees do not recurse.
+  template<typename Output>
+  void write_value(Output& out, const value& root) {
+    struct frame {
+      const value* container;
+      std::size_t index;
+    };
+    std::vector<frame> open;
+
+    const value* current = &root;
+    while (current != nullptr) {
+      current->visit([&out, &open, current]<typename T>(const T & v) {
+        if constexpr (std::is_same_v<T, null>) {
+          out.write("null");
+        }
+        else if constexpr (std::is_same_v<T, boolean>) {
+          out.write(v.value() ? "true" : "false");
+        }
+        else if constexpr (std::is_same_v<T, string>) {
+          write_string(out, v.view());
+        }
+        else if constexpr (std::is_same_v<T, number>) {
+          write_number(out, v.value());
+        }
+        else if constexpr (std::is_same_v<T, object>) {
+          out.put('{');
+          open.push_back({ current, 0 });
+        }
+        else if constexpr (std::is_same_v<T, array>) {
+          out.put('[');
+          open.push_back({ current, 0 });
+        }
+      });
+
+      // Moves on to the next element or member, closing the containers that are done
+      current = nullptr;
+      while (current == nullptr && !open.empty()) {
+        const value& container = *open.back().container;
+        std::size_t& index = open.back().index;
+        if (const array* arr = container.get_if<array>()) {
+          if (index == arr->size()) {
+            out.put(']');
+            open.pop_back();
+            continue;
+          }
+          if (index != 0) {
+            out.put(',');
+          }
+          current = &(*arr)[index++];
+        }
+        else {
+          const object& obj = container.get<object>();
+          if (index == obj.size()) {
+            out.put('}');
+            open.pop_back();
+            continue;
+          }
+          if (index != 0) {
+            out.put(',');
+          }
+          const auto& [key, member] = *(obj.begin() + static_cast<std::ptrdiff_t>(index++));
+          write_string(out, key);
+          out.put(':');
+          current = &member;
+        }
+      }
+    }
+  }
+
+}
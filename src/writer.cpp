@@ -0,0 +1,90 @@
+#include <json/writer.hpp>
+
+#include "output.hpp"
+#include "write.hpp"
+
+namespace json {
+
+  void writer::separator() {
+    if (_separate) {
+      _out.push_back(',');
+    }
+    _separate = true;
+  }
+
+  void writer::begin_object() {
+    separator();
+    _out.push_back('{');
+    _separate = false;
+  }
+
+  void writer::end_object() {
+    _out.push_back('}');
+    _separate = true;
+  }
+
+  void writer::begin_array() {
+    separator();
+    _out.push_back('[');
+    _separate = false;
+  }
+
+  void writer::end_array() {
+    _out.push_back(']');
+    _separate = true;
+  }
+
+  void writer::key(const std::string_view name) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_string(output, name);
+    _out.push_back(':');
+    _separate = false;
+  }
+
+  void writer::value(std::nullptr_t) {
+    separator();
+    _out.append("null");
+  }
+
+  void writer::value(const bool b) {
+    separator();
+    _out.append(b ? "true" : "false");
+  }
+
+  void writer::value(const double d) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_number(output, d);
+  }
+
+  void writer::value(const std::int64_t i) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_integer(output, i);
+  }
+
+  void writer::value(const std::uint64_t i) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_integer(output, i);
+  }
+
+  void writer::value(const std::string_view str) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_string(output, str);
+  }
+
+  void writer::value(const json::value& val) {
+    separator();
+    internal::string_output output(_out);
+    internal::write_value(output, val);
+  }
+
+  void writer::raw(const std::string_view json) {
+    separator();
+    _out.append(json);
+  }
+
+}
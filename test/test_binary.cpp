@@ -0,0 +1,131 @@
+#include <json/binary.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "macros.hpp"
+
+using bytes = std::vector<std::uint8_t>;
+
+template<typename F>
+static bool fails(F&& decode, const bytes& data) {
+  try {
+    (void)decode(data, json::parse_options{});
+  }
+  catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+static json::value cbor(const bytes& data, const json::parse_options& options) { return json::from_cbor(data, options); }
+static json::value msgpack(const bytes& data, const json::parse_options& options) { return json::from_msgpack(data, options); }
+
+int main() {
+
+  const std::vector<std::string> documents = {
+    "null", "true", "0", "-1", "23", "24", "-24", "-25", "255", "256", "65535", "65536", "4294967296",
+    "-129", "-32769", "-2147483649", "1.5", "0.1", "-0.0", "1e300", "18446744073709551615", "-9223372036854775808",
+    "\"\"", "\"caf\\u00e9\"", "[]", "{}",
+    R"({"name": "x", "list": [1, 2.5, null, false, {"nested": ["a", "b"]}], "empty": {}, "big": 12345678901})",
+  };
+
+  // Round trips
+  for (const auto& doc : documents) {
+    const auto val = json::parse(doc);
+    const auto from_cbor = json::from_cbor(json::to_cbor(val));
+    const auto from_msgpack = json::from_msgpack(json::to_msgpack(val));
+    ASSERT_TRUE(from_cbor == val);
+    ASSERT_TRUE(from_msgpack == val);
+    ASSERT_TRUE(from_cbor.dump() == val.dump());
+    ASSERT_TRUE(from_msgpack.dump() == val.dump());
+  }
+
+  // Containers past the short forms
+  {
+    json::array arr;
+    json::object obj;
+    for (int i = 0; i < 70000; ++i) {
+      arr.push_back(i);
+      obj[std::to_string(i)] = std::string(i % 300, 'x');
+    }
+    const json::value val = json::object{ {"arr", std::move(arr)}, {"obj", std::move(obj)} };
+    ASSERT_TRUE(json::from_cbor(json::to_cbor(val)) == val);
+    ASSERT_TRUE(json::from_msgpack(json::to_msgpack(val)) == val);
+  }
+
+  // Encodings from RFC 8949 appendix A
+  {
+    ASSERT_TRUE(json::to_cbor(0) == bytes({ 0x00 }));
+    ASSERT_TRUE(json::to_cbor(24) == bytes({ 0x18, 0x18 }));
+    ASSERT_TRUE(json::to_cbor(1000) == bytes({ 0x19, 0x03, 0xe8 }));
+    ASSERT_TRUE(json::to_cbor(-1000) == bytes({ 0x39, 0x03, 0xe7 }));
+    ASSERT_TRUE(json::to_cbor(-1) == bytes({ 0x20 }));
+    ASSERT_TRUE(json::to_cbor(-100) == bytes({ 0x38, 0x63 }));
+    ASSERT_TRUE(json::to_cbor(1000000000000) == bytes({ 0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00 }));
+    ASSERT_TRUE(json::to_cbor(json::parse("-9223372036854775808")) == bytes({ 0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }));
+    ASSERT_TRUE(json::to_cbor(-0x1p60) == bytes({ 0x3b, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }));
+    ASSERT_TRUE(json::to_cbor(-4.1) == bytes({ 0xfb, 0xc0, 0x10, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66 }));
+    ASSERT_TRUE(json::to_cbor(1.0e+300) == bytes({ 0xfb, 0x7e, 0x37, 0xe4, 0x3c, 0x88, 0x00, 0x75, 0x9c }));
+    ASSERT_TRUE(json::to_cbor(3.4028234663852886e+38) == bytes({ 0xfa, 0x7f, 0x7f, 0xff, 0xff }));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }) == json::parse("18446744073709551615"));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0x3b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }) == json::value(-0x1p64));
+    ASSERT_TRUE(json::to_cbor(1.1) == bytes({ 0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a }));
+    ASSERT_TRUE(json::to_cbor(json::parse(R"({"a": 1, "b": [2, 3]})")) == bytes({ 0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03 }));
+
+    ASSERT_TRUE(json::from_cbor(bytes{ 0xf9, 0x3e, 0x00 }) == json::value(1.5));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0xf9, 0xc4, 0x00 }) == json::value(-4.0));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0xf9, 0x00, 0x01 }) == json::value(5.960464477539063e-8));
+    ASSERT_TRUE(std::isinf(json::from_cbor(bytes{ 0xf9, 0x7c, 0x00 }).get<json::number>().value()));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0xc1, 0x1a, 0x51, 0x4b, 0x67, 0xb0 }) == json::value(1363896240));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0x9f, 0x01, 0x82, 0x02, 0x03, 0x9f, 0x04, 0x05, 0xff, 0xff }) == json::parse("[1, [2, 3], [4, 5]]"));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0xbf, 0x61, 0x61, 0x01, 0x61, 0x62, 0x9f, 0x02, 0x03, 0xff, 0xff }) == json::parse(R"({"a": 1, "b": [2, 3]})"));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0x7f, 0x65, 0x73, 0x74, 0x72, 0x65, 0x61, 0x64, 0x6d, 0x69, 0x6e, 0x67, 0xff }) == json::value("streaming"));
+  }
+
+  // MessagePack formats
+  {
+    ASSERT_TRUE(json::to_msgpack(127) == bytes({ 0x7f }));
+    ASSERT_TRUE(json::to_msgpack(-32) == bytes({ 0xe0 }));
+    ASSERT_TRUE(json::to_msgpack(200) == bytes({ 0xcc, 0xc8 }));
+    ASSERT_TRUE(json::to_msgpack(-33) == bytes({ 0xd0, 0xdf }));
+    ASSERT_TRUE(json::to_msgpack(0.5) == bytes({ 0xca, 0x3f, 0x00, 0x00, 0x00 }));
+    ASSERT_TRUE(json::to_msgpack(json::parse(R"({"a": [true]})")) == bytes({ 0x81, 0xa1, 0x61, 0x91, 0xc3 }));
+    ASSERT_TRUE(json::from_msgpack(bytes{ 0xd9, 0x01, 0x78 }) == json::value("x"));
+  }
+
+  // Malformed and unsupported input
+  {
+    ASSERT_TRUE(fails(cbor, {}));
+    ASSERT_TRUE(fails(cbor, { 0x19, 0x03 }));
+    ASSERT_TRUE(fails(cbor, { 0x83, 0x01, 0x02 }));
+    ASSERT_TRUE(fails(cbor, { 0x01, 0x02 }));
+    ASSERT_TRUE(fails(cbor, { 0x42, 0x01, 0x02 }));
+    ASSERT_TRUE(fails(cbor, { 0xa1, 0x01, 0x02 }));
+    ASSERT_TRUE(fails(cbor, { 0xff }));
+    ASSERT_TRUE(fails(cbor, { 0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }));
+
+    ASSERT_TRUE(fails(msgpack, {}));
+    ASSERT_TRUE(fails(msgpack, { 0xcd, 0x01 }));
+    ASSERT_TRUE(fails(msgpack, { 0x92, 0x01 }));
+    ASSERT_TRUE(fails(msgpack, { 0xc4, 0x01, 0x00 }));
+    ASSERT_TRUE(fails(msgpack, { 0x81, 0x01, 0x02 }));
+    ASSERT_TRUE(fails(msgpack, { 0xc1 }));
+
+    bytes deep_cbor(100000, 0x81);
+    deep_cbor.push_back(0x00);
+    bytes deep_msgpack(100000, 0x91);
+    deep_msgpack.push_back(0x00);
+    ASSERT_TRUE(fails(cbor, deep_cbor));
+    ASSERT_TRUE(fails(msgpack, deep_msgpack));
+    ASSERT_TRUE(json::from_cbor(bytes{ 0x81, 0x81, 0x00 }, { .max_depth = 2 }) == json::parse("[[0]]"));
+    ASSERT_TRUE(json::from_msgpack(bytes{ 0x91, 0x91, 0x00 }, { .max_depth = 2 }) == json::parse("[[0]]"));
+  }
+
+  return 0;
+}
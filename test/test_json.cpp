@@ -1,6 +1,12 @@
 #include <json/json.hpp>
 
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <memory_resource>
 
 #include "macros.hpp"
 
@@ -35,6 +41,37 @@ int main() {
   arr.push_back(json::array{ 1, 2, 3 });
   arr.push_back(json::object{ {"key1", 1}, {"key2", 2} });
 
+  // Compact nodes on 64 bit targets
+  ASSERT_TRUE(sizeof(void*) != 8 || sizeof(json::value) == 16);
+  ASSERT_TRUE(json::value().is<json::array>());
+
+  // Default constructed values allocate nothing until they are modified
+  {
+    class counting_resource : public std::pmr::memory_resource {
+    public:
+      std::size_t allocations = 0;
+    private:
+      void* do_allocate(const std::size_t bytes, const std::size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+      }
+      void do_deallocate(void* p, const std::size_t bytes, const std::size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+      }
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    } counting;
+
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counting);
+    json::value empty;
+    json::value copy = empty;
+    const bool unallocated = counting.allocations == 0 && empty.size() == 0 && copy == json::array{} && empty.dump() == "[]";
+    empty.get<json::array>().push_back(1);
+    const bool allocated = counting.allocations > 0 && empty == json::array{ 1 };
+    std::pmr::set_default_resource(previous);
+    ASSERT_TRUE(unallocated);
+    ASSERT_TRUE(allocated);
+  }
+
   // Getters
   ASSERT_TRUE(val.size() == 6);
   ASSERT_TRUE(val["key1"].get<json::number>().value() == 1.0);
@@ -61,7 +98,128 @@ int main() {
     std::cout << v.get<json::number>().value() << '\n';
   }
 
+  // Arena backed document
+  {
+    const json::document doc("{\"key1\": [1, \"value2\", {\"key3\": null}], \"key2\": \"value2\"}");
+    ASSERT_TRUE(doc.root()["key1"][1].get<json::string>().value() == "value2");
+    ASSERT_TRUE(doc.root()["key1"][2]["key3"].is<json::null>());
+    ASSERT_TRUE(doc.root()["key1"].get<json::array>().get_allocator().resource() == doc.resource());
+    ASSERT_TRUE(doc.root().get<json::object>().get_allocator().resource() == doc.resource());
+
+    const json::document arr_doc("[[1], 2]");
+    ASSERT_TRUE(arr_doc.root().get<json::array>().get_allocator().resource() == arr_doc.resource());
+    ASSERT_TRUE(arr_doc.root()[0].get<json::array>().get_allocator().resource() == arr_doc.resource());
+
+    // Copies leave the arena
+    json::value copy = doc.root();
+    ASSERT_TRUE(copy == doc.root());
+    ASSERT_TRUE(copy["key1"].get<json::array>().get_allocator().resource() == std::pmr::get_default_resource());
+  }
 
+  // Borrowed strings
+  {
+    const std::string src = "{\"plain\": \"value\", \"escaped\": \"a\\nb\", \"list\": [\"x\", \"\"]}";
+    const json::document doc(src, { .borrow_strings = true });
+    const auto in_source = [&src](const std::string_view s) {
+      return s.data() >= src.data() && s.data() + s.size() <= src.data() + src.size();
+    };
+
+    const auto& plain = doc.root()["plain"].get<json::string>();
+    ASSERT_TRUE(plain.is_borrowed());
+    ASSERT_TRUE(plain.view() == "value");
+    ASSERT_TRUE(in_source(plain.view()));
+
+    const auto& escaped = doc.root()["escaped"].get<json::string>();
+    ASSERT_TRUE(escaped.is_borrowed());
+    ASSERT_TRUE(escaped.view() == "a\nb");
+    ASSERT_FALSE(in_source(escaped.view()));
+
+    ASSERT_TRUE(doc.root()["list"][1].get<json::string>().view().empty());
+    ASSERT_TRUE(doc.root() == json::parse(src));
+
+    // Copies own their characters
+    const json::value copy = doc.root();
+    ASSERT_FALSE(copy["plain"].get<json::string>().is_borrowed());
+    ASSERT_TRUE(copy == doc.root());
+
+    // Without the option strings are copied into the arena
+    const json::document copied(src);
+    ASSERT_FALSE(copied.root()["plain"].get<json::string>().is_borrowed());
+  }
+
+  // Parse from file
+  {
+    const auto path = std::filesystem::temp_directory_path() / "cpp_json_test_parse_file.json";
+    {
+      std::ofstream out(path, std::ios::binary);
+      out << "{\"key1\": [1, 2, 3], \"key2\": \"value2\"}";
+    }
+    const auto parsed = json::parse_file(path);
+    std::filesystem::remove(path);
+    ASSERT_TRUE(parsed == json::object({ {"key1", json::array{1, 2, 3}}, {"key2", "value2"} }));
+
+    bool threw = false;
+    try { json::parse_file(path); }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+  }
+
+
+  // Serialization
+  {
+    json::array big;
+    for (int i = 0; i < 10000; ++i) {
+      big.push_back(json::object{ {"id", i}, {"name", "quote \" and backslash \\"} });
+    }
+    const json::value doc = json::object{ {"items", std::move(big)}, {"flag", false}, {"none", nullptr} };
+
+    const auto dumped = doc.dump();
+    ASSERT_TRUE(dumped.size() > 64 * 1024);
+    ASSERT_TRUE(json::parse(dumped) == doc);
+
+    std::string appended = "prefix";
+    doc.dump_to(appended);
+    ASSERT_TRUE(appended == "prefix" + dumped);
+
+    std::ostringstream ss;
+    doc.dump_to(ss);
+    ASSERT_TRUE(ss.str() == dumped);
+
+    // Control characters are escaped
+    ASSERT_TRUE(json::value("a\"b\\c\n\t\x01\xC3\xA8").dump() == "\"a\\\"b\\\\c\\n\\t\\u0001\xC3\xA8\"");
+    {
+      std::string all;
+      for (int c = 1; c < 128; ++c) {
+        all += static_cast<char>(c);
+      }
+      const json::value str = json::object{ { std::pmr::string(all), all } };
+      ASSERT_TRUE(json::parse(str.dump()) == str);
+    }
+
+    // Numbers use the shortest form that round-trips
+    ASSERT_TRUE(json::value(1).dump() == "1");
+    ASSERT_TRUE(json::value(-42).dump() == "-42");
+    ASSERT_TRUE(json::value(0.1).dump() == "0.1");
+    ASSERT_TRUE(json::value(1e-9).dump() == "1e-09");
+    ASSERT_TRUE(json::value(-0.0).dump() == "-0");
+    ASSERT_TRUE(json::value(std::nan("")).dump() == "null");
+    for (const double d : { 0.1 + 0.2, 1e-9, 123456789012.5, 1e300, -2.5e-300, 9007199254740993.0, 1e19 }) {
+      ASSERT_TRUE(json::parse(json::value(d).dump()) == json::value(d));
+    }
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_TRUE(file != nullptr);
+#ifdef _WIN32
+    doc.dump_to_fd(_fileno(file));
+#else
+    doc.dump_to_fd(fileno(file));
+#endif
+    std::rewind(file);
+    std::string from_fd(dumped.size() + 1, '\0');
+    from_fd.resize(std::fread(from_fd.data(), 1, from_fd.size(), file));
+    std::fclose(file);
+    ASSERT_TRUE(from_fd == dumped);
+  }
 
   return 0;
 }
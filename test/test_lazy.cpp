@@ -0,0 +1,80 @@
+#include <json/lazy.hpp>
+
+#include <iostream>
+
+#include "macros.hpp"
+
+int main() {
+
+  try {
+    const std::string src = R"({
+      "skipped": {"nested": [1, 2, {"deep": "]}\"["}], "more": null},
+      "data": {
+        "count": 3,
+        "items": [ {"id": 1, "name": "a"}, {"id": 2, "name": "b\"c"}, {"id": 3, "name": "d"} ],
+        "ok": true,
+        "escaped": "yes"
+      }
+    })";
+
+    const json::lazy_document doc(src);
+
+    ASSERT_TRUE(doc.root().is<json::object>());
+    ASSERT_TRUE(doc["data"]["count"].get<json::number>().value() == 3.0);
+    ASSERT_TRUE(doc["data"]["ok"].get<json::boolean>().value());
+    ASSERT_TRUE(doc["data"]["items"].size() == 3);
+    ASSERT_TRUE(doc["data"]["items"][1]["name"].get<json::string>().value() == "b\"c");
+    ASSERT_TRUE(doc["data"]["escaped"].get<json::string>().value() == "yes");
+    ASSERT_TRUE(doc["skipped"]["nested"][2]["deep"].get<json::string>().value() == "]}\"[");
+    ASSERT_TRUE(doc["skipped"]["more"].is<json::null>());
+    ASSERT_TRUE(doc["data"].size() == 4);
+    ASSERT_FALSE(doc["data"].get<json::object>().contains("missing"));
+
+    double sum = 0;
+    for (const auto item : doc["data"]["items"].get<json::array>()) {
+      sum += item["id"].get<json::number>().value();
+    }
+    ASSERT_TRUE(sum == 6.0);
+
+    std::size_t members = 0;
+    for (const auto [key, v] : doc.root().get<json::object>()) {
+      std::cout << key << '\n';
+      ++members;
+    }
+    ASSERT_TRUE(members == 2);
+
+    ASSERT_TRUE(doc["data"]["items"][0].to_value() == json::object({ {"id", 1}, {"name", "a"} }));
+    ASSERT_TRUE(doc["data"]["items"][0].raw() == R"({"id": 1, "name": "a"})");
+    ASSERT_TRUE(json::lazy_document("[]").root().get<json::array>().empty());
+    ASSERT_TRUE(json::lazy_document(" 12 ").root().get<json::number>().value() == 12.0);
+
+    bool threw = false;
+    try { (void)doc["data"]["count"].get<json::string>(); }
+    catch (std::bad_variant_access&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    threw = false;
+    try { (void)doc["data"]["items"][3]; }
+    catch (std::out_of_range&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    // Duplicate keys resolve to the last member, as with json::parse
+    {
+      const std::string_view src = R"({"a": 1, "b": true, "\u0061": 2, "c": null})";
+      const json::lazy_document dup(src);
+      ASSERT_TRUE(dup["a"].to_value() == json::parse(src)["a"]);
+      ASSERT_TRUE(dup.root().to_value() == json::parse(src));
+    }
+
+    threw = false;
+    try { (void)json::lazy_document("{\"a\": [1, 2").root()["b"]; }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
@@ -1,9 +1,13 @@
 #include <vector>
 #include <sstream>
 #include <iostream>
+#include <limits>
+#include <cmath>
+#include <string>
+#include <utility>
 #include "json/json.hpp"
 
-#include <lexer.hpp>
+#include <json/internal/lexer.hpp>
 
 #include "macros.hpp"
 
@@ -23,7 +27,7 @@ void test_lexer(const std::string_view input, const std::vector<json::internal::
 int main() {
 
   try {
-    test_lexer(",:{}[]()12312\"Hello, World!\".123 true false", { 
+    test_lexer(",:{}[]()12312\"Hello, World!\"0.123 true false", { 
       json::internal::token_types::comma{}, 
       json::internal::token_types::colon{}, 
       json::internal::token_types::open_curly{}, 
@@ -40,6 +44,74 @@ int main() {
       json::internal::token_types::eof{},
     });
     
+    {
+      json::internal::lexer lex(std::string_view{ "[\"a\\\"b\\n\\u00e8\", 2]" });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::open_square{});
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::string_literal{ "a\"b\n\xC3\xA8" });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::comma{});
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ 2 });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::close_square{});
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::eof{});
+    }
+
+    {
+      // Strings without escapes are views of the input
+      const std::string_view src = "\"abc\" \"a\\tc\"";
+      json::internal::lexer lex(src);
+      const auto plain = std::get<json::internal::token_types::string_literal>(lex.next_token()).value;
+      ASSERT_TRUE(plain == "abc" && plain.data() == src.data() + 1);
+      const auto escaped = std::get<json::internal::token_types::string_literal>(lex.next_token()).value;
+      ASSERT_TRUE(escaped == "a\tc");
+    }
+
+    {
+      json::internal::lexer lex(std::string_view{ "[-12, 0, -0.5, 1.5e3, 2E-2, 1e+2, 18446744073709551615, 123456789012345678901234]" });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::open_square{});
+      for (const double expected : { -12.0, 0.0, -0.5, 1500.0, 0.02, 100.0, 18446744073709551615.0, 123456789012345678901234.0 }) {
+        ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ expected });
+        lex.next_token();
+      }
+    }
+
+    {
+      // Conversions are exact: 0.1 + 0.2 must not lose the last bit
+      json::internal::lexer lex(std::string_view{ "0.30000000000000004 9007199254740993 1e400 1e-400" });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ 0.1 + 0.2 });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ 9007199254740992.0 });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ std::numeric_limits<double>::infinity() });
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{ 0.0 });
+    }
+
+    {
+      // Out of range values saturate from their digits alone, whatever the locale
+      using json::internal::token_types::number_literal;
+      const double inf = std::numeric_limits<double>::infinity();
+      const std::string long_integer = "1" + std::string(400, '0');
+      const std::pair<std::string_view, double> saturated[] = {
+        { "-1e400", -inf }, { "1.5E+309", inf }, { "0.001e312", inf }, { long_integer, inf },
+        { "-1e-400", -0.0 }, { "123e-500", 0.0 }, { "0.000001e-320", 0.0 }, { "1000e-330", 0.0 },
+        { "1e99999999999999999999", inf }, { "1e-99999999999999999999", 0.0 },
+      };
+      for (const auto& [src, expected] : saturated) {
+        json::internal::lexer lex(src);
+        const auto tok = lex.next_token();
+        const auto* num = std::get_if<number_literal>(&tok);
+        ASSERT_TRUE(num && num->value == expected && std::signbit(num->value) == std::signbit(expected));
+      }
+    }
+
+    for (const std::string_view invalid : { ".5", "01", "-", "-a", "1.", "1.e5", "1e", "1e+" }) {
+      json::internal::lexer lex(invalid);
+      bool thrown = false;
+      try {
+        lex.next_token();
+      }
+      catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      ASSERT_TRUE(thrown);
+    }
+
     {
       std::stringstream ss("1{[]");
       json::internal::lexer lex(ss);
@@ -52,6 +124,13 @@ int main() {
       ASSERT_TRUE(lex.next_token() == json::internal::token_types::number_literal{1});
       ASSERT_TRUE(lex.peek_token() == json::internal::token_types::open_curly{});
       ASSERT_TRUE(lex.peek_token() == json::internal::token_types::open_curly{});
+
+      // Marking after a peek must point before the peeked token
+      const auto peeked = lex.mark();
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::open_curly{});
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::open_square{});
+      lex.reset(peeked);
+      ASSERT_TRUE(lex.next_token() == json::internal::token_types::open_curly{});
       return 0;
 
     }
@@ -0,0 +1,123 @@
+#include <json/ndjson.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+
+#include "macros.hpp"
+
+int main() {
+
+  try {
+    // Sequential stream of concatenated documents
+    {
+      json::document_stream stream("{\"a\": 1} [1, 2]\n\n\"s\" 3 null");
+      std::vector<json::value> values;
+      for (auto& v : stream) {
+        values.push_back(std::move(v));
+      }
+      ASSERT_TRUE(values.size() == 5);
+      ASSERT_TRUE(values[0] == json::object({ {"a", 1} }));
+      ASSERT_TRUE(values[1] == json::array({ 1, 2 }));
+      ASSERT_TRUE(values[2] == json::string("s"));
+      ASSERT_TRUE(values[3] == json::number(3));
+      ASSERT_TRUE(values[4].is<json::null>());
+
+      json::document_stream empty("  \n ");
+      ASSERT_TRUE(empty.begin() == empty.end());
+    }
+
+    std::string src;
+    for (int i = 0; i < 2000; ++i) {
+      src += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"x\", \"y\"]}\n";
+      if (i % 100 == 0) {
+        src += "\n";
+      }
+    }
+
+    // Small batches force the parallel path
+    const json::ndjson_options options{ .threads = 4, .min_parallel_size = 0 };
+
+    {
+      const auto values = json::parse_ndjson(src, options);
+      ASSERT_TRUE(values.size() == 2000);
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        ASSERT_TRUE(values[i]["id"].get<json::number>().value() == static_cast<double>(i));
+      }
+      ASSERT_TRUE(values == json::parse_ndjson(src, { .threads = 1 }));
+    }
+
+    {
+      std::atomic<std::size_t> count{ 0 };
+      std::atomic<long> sum{ 0 };
+      json::parse_ndjson(src, [&](json::value&& v) {
+        ++count;
+        sum += v["id"].get<json::number>().as<long>();
+      }, options);
+      ASSERT_TRUE(count == 2000);
+      ASSERT_TRUE(sum == 1999 * 2000 / 2);
+    }
+
+    {
+      bool threw = false;
+      try { (void)json::parse_ndjson(src + "{\"broken\": \n", options); }
+      catch (std::runtime_error& err) { std::cout << err.what() << '\n'; threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    const auto throws = [](const std::string& text, const json::ndjson_options& opts) {
+      try { (void)json::parse_ndjson(text, opts); }
+      catch (std::runtime_error& err) { std::cout << err.what() << '\n'; return true; }
+      return false;
+    };
+
+    // One document per line, whatever path the input takes
+    {
+      for (const auto& opts : { options, json::ndjson_options{ .threads = 1 } }) {
+        ASSERT_TRUE(throws("{\"a\":\n1}\n", opts));
+        ASSERT_TRUE(throws("1 2\n", opts));
+        ASSERT_FALSE(throws(" 1 \r\n\n  \n[2]", opts));
+      }
+      ASSERT_TRUE(json::parse_ndjson(" 1 \r\n\n  \n[2]", options).size() == 2);
+    }
+
+    // The depth limit applies to every line, in both directions
+    {
+      const std::string deep = std::string(json::default_max_depth + 1, '[') + std::string(json::default_max_depth + 1, ']') + "\n";
+      for (const std::size_t threads : { std::size_t{ 1 }, std::size_t{ 4 } }) {
+        const json::ndjson_options raised{ .threads = threads, .min_parallel_size = 0, .max_depth = 5000 };
+        const json::ndjson_options lowered{ .threads = threads, .min_parallel_size = 0, .max_depth = 2 };
+        ASSERT_TRUE(json::parse_ndjson(deep + deep, raised).size() == 2);
+        ASSERT_TRUE(throws(deep, { .threads = threads, .min_parallel_size = 0 }));
+        ASSERT_TRUE(throws("1\n[[[1]]]\n", lowered));
+        ASSERT_TRUE(json::parse_ndjson("1\n[[1]]\n", lowered).size() == 2);
+      }
+
+      json::document_stream stream("[[1]] [[[1]]]", { .max_depth = 2 });
+      json::value v;
+      ASSERT_TRUE(stream.next(v));
+      bool threw = false;
+      try { (void)stream.next(v); }
+      catch (std::runtime_error&) { threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    // Exceptions thrown by the callback are not reported as parse errors
+    for (const auto& opts : { options, json::ndjson_options{ .threads = 1 } }) {
+      std::string what;
+      try {
+        json::parse_ndjson(src, [](json::value&&) { throw std::runtime_error("stop"); }, opts);
+      }
+      catch (std::runtime_error& err) {
+        what = err.what();
+      }
+      ASSERT_TRUE(what == "stop");
+    }
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,107 @@
+#include <json/json.hpp>
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "macros.hpp"
+
+int main() {
+
+  // Insertion order is kept
+  {
+    json::object obj{ {"b", 1}, {"a", 2}, {"c", 3} };
+    obj["d"] = 4;
+    obj.insert_or_assign("a", 5);
+
+    std::string keys;
+    for (const auto& [key, v] : obj) {
+      keys += key;
+    }
+    ASSERT_TRUE(keys == "bacd");
+    ASSERT_TRUE(obj.at("a") == json::value(5));
+    ASSERT_TRUE(json::parse("{\"z\": 1, \"y\": 2, \"x\": 3}").get<json::object>().begin()->first == "z");
+  }
+
+  // Lookups by std::string_view
+  {
+    const json::object obj{ {"key1", 1}, {"key2", "value2"} };
+    const std::string_view key = "key2";
+    ASSERT_TRUE(obj.contains(key));
+    ASSERT_TRUE(obj.find(key)->second == json::value("value2"));
+    ASSERT_TRUE(obj.find("missing") == obj.end());
+    ASSERT_TRUE(obj.count("key1") == 1);
+
+    bool threw = false;
+    try { (void)obj.at("missing"); }
+    catch (std::out_of_range&) { threw = true; }
+    ASSERT_TRUE(threw);
+  }
+
+  // Duplicates: insert keeps the first value, insert_or_assign the last
+  {
+    json::object obj{ {"a", 1}, {"a", 2} };
+    ASSERT_TRUE(obj.size() == 1);
+    ASSERT_TRUE(obj["a"] == json::value(1));
+    ASSERT_FALSE(obj.try_emplace("a", 3).second);
+    ASSERT_TRUE(json::parse("{\"a\": 1, \"a\": 2}")["a"] == json::value(2));
+  }
+
+  // Large objects are indexed, lookups and erasure keep working past the threshold
+  {
+    json::object obj;
+    for (int i = 0; i < 1000; ++i) {
+      obj[std::to_string(i)] = i;
+    }
+    ASSERT_TRUE(obj.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(obj.at(std::to_string(i)) == json::value(i));
+    }
+    ASSERT_FALSE(obj.contains("1000"));
+
+    ASSERT_TRUE(obj.erase("500") == 1);
+    ASSERT_TRUE(obj.erase("500") == 0);
+    ASSERT_FALSE(obj.contains("500"));
+    ASSERT_TRUE(obj.at("501") == json::value(501));
+    ASSERT_TRUE(obj.size() == 999);
+
+    for (int i = 0; i < 990; ++i) {
+      obj.erase(obj.begin());
+    }
+    ASSERT_TRUE(obj.size() == 9);
+    ASSERT_TRUE(obj.at("999") == json::value(999));
+    ASSERT_TRUE(obj.begin()->first == "991");
+  }
+
+  // Keys cannot be modified in place, growing moves the values instead of copying them
+  {
+    static_assert(!std::is_assignable_v<decltype((json::object().begin()->first)), std::pmr::string>);
+
+    json::object obj;
+    obj["a"] = json::array{ 1, 2, 3 };
+    const json::array* boxed = &obj.at("a").get<json::array>();
+    for (int i = 0; i < 100; ++i) {
+      obj.try_emplace(std::to_string(i), obj.at("a"));
+    }
+    ASSERT_TRUE(&obj.at("a").get<json::array>() == boxed);
+    ASSERT_TRUE(obj.at("99") == json::value(json::array{ 1, 2, 3 }));
+
+    json::object other;
+    other = obj;
+    ASSERT_TRUE(other == obj);
+    json::object moved;
+    moved = std::move(other);
+    ASSERT_TRUE(moved == obj);
+  }
+
+  // Equality ignores the order of the members
+  {
+    const json::object lhs{ {"a", 1}, {"b", json::array{ 1, 2 }} };
+    const json::object rhs{ {"b", json::array{ 1, 2 }}, {"a", 1} };
+    ASSERT_TRUE(lhs == rhs);
+    ASSERT_FALSE(lhs == json::object({ {"a", 1} }));
+    ASSERT_FALSE(lhs == json::object({ {"a", 1}, {"c", json::array{ 1, 2 }} }));
+  }
+
+  return 0;
+}
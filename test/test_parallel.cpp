@@ -0,0 +1,66 @@
+#include <json/json.hpp>
+
+#include <iostream>
+#include <string>
+
+#include "macros.hpp"
+
+bool parallel_test(const std::string& src) {
+  return json::parse_parallel(src, { .threads = 4, .min_parallel_size = 0 }) == json::parse(src);
+}
+
+bool parallel_throws_with(const std::string& src, const std::size_t max_depth) {
+  try {
+    (void)json::parse_parallel(src, { .threads = 4, .min_parallel_size = 0, .max_depth = max_depth });
+  }
+  catch (std::runtime_error& err) {
+    std::cout << err.what() << '\n';
+    return true;
+  }
+  return false;
+}
+
+bool parallel_throws(const std::string& src) {
+  return parallel_throws_with(src, json::default_max_depth);
+}
+
+int main() {
+
+  try {
+    std::string src = "[";
+    for (int i = 0; i < 1000; ++i) {
+      src += "{\"id\": " + std::to_string(i) + ", \"s\": \"a,]}\\\"[{\", \"n\": [1, [2, {\"x\": null}]]},\n";
+    }
+    src += "true]";
+
+    ASSERT_TRUE(parallel_test(src));
+    ASSERT_TRUE(parallel_test("[1]"));
+    ASSERT_TRUE(parallel_test("[1, 2, 3]"));
+    ASSERT_TRUE(parallel_test("[]"));
+    ASSERT_TRUE(parallel_test("  [ [], {}, \"x\" ]  "));
+    ASSERT_TRUE(parallel_test("{\"a\": [1, 2]}"));
+    ASSERT_TRUE(parallel_test("42"));
+
+    ASSERT_TRUE(parallel_throws("[1, 2,]"));
+    ASSERT_TRUE(parallel_throws("[1, 2 3]"));
+    ASSERT_TRUE(parallel_throws("[1, [2, 3]"));
+    ASSERT_TRUE(parallel_throws("[1, {\"a\" 2}]"));
+
+    // The root array counts towards the depth limit, as in parse()
+    {
+      const auto nested = [](const std::size_t depth) {
+        return "[1, " + std::string(depth - 1, '[') + std::string(depth - 1, ']') + "]";
+      };
+      ASSERT_TRUE(parallel_test(nested(json::default_max_depth)));
+      ASSERT_TRUE(parallel_throws(nested(json::default_max_depth + 1)));
+      ASSERT_TRUE(json::parse_parallel("[1, [2], [[3]]]", { .threads = 4, .min_parallel_size = 0, .max_depth = 3 }) == json::parse("[1, [2], [[3]]]"));
+      ASSERT_TRUE(parallel_throws_with("[1, [2], [[3]]]", 2));
+    }
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
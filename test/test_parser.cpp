@@ -1,3 +1,6 @@
+#include <json/internal/lexer.hpp>
+
+#include <string>
 #include <string_view>
 #include <sstream>
 #include <iostream>
@@ -5,8 +8,6 @@
 #include "macros.hpp"
 
 #include "parser.hpp"
-#include "lexer.hpp"
-
 
 bool parse_test(const std::string_view src, const json::value comp) {
   std::stringstream ss(std::string{ src });
@@ -44,6 +45,49 @@ int main() {
       ASSERT_TRUE(parse_test("[[]]", json::array{ { json::array{} } }));
       ASSERT_TRUE(parse_test("[[1, 2, 3]]", json::array{ { json::array{1, 2, 3} } }));
     }
+
+    // Nesting is limited instead of exhausting the stack
+    {
+      const auto nested = [](const std::size_t depth) {
+        return std::string(depth, '[') + std::string(depth, ']');
+      };
+
+      const auto fails = [](const std::string_view src, const json::parse_options& options) {
+        try {
+          (void)json::parse(src, options);
+        }
+        catch (std::runtime_error&) {
+          return true;
+        }
+        return false;
+      };
+
+      ASSERT_FALSE(fails(nested(json::default_max_depth), {}));
+      ASSERT_TRUE(fails(nested(json::default_max_depth + 1), {}));
+      ASSERT_TRUE(fails(std::string(1000000, '['), {}));
+      ASSERT_TRUE(fails(std::string(1000000, '['), { .max_depth = 1000000 }));
+      ASSERT_FALSE(fails("[[1], {\"a\": [2]}]", { .max_depth = 3 }));
+      ASSERT_TRUE(fails("[[1], {\"a\": [2]}]", { .max_depth = 2 }));
+      ASSERT_FALSE(fails(nested(100000), { .max_depth = 100000 }));
+
+      // Deep trees are also compared, serialized and destroyed without recursing
+      const auto deep = json::parse(nested(100000), { .max_depth = 100000 });
+      ASSERT_TRUE(deep == json::parse(nested(100000), { .max_depth = 100000 }));
+      ASSERT_FALSE(deep == json::parse(nested(99999), { .max_depth = 100000 }));
+      ASSERT_TRUE(deep.dump() == nested(100000));
+    }
+
+    // The stack storage can be shared by successive parses
+    {
+      json::internal::parse_stack stack;
+      for (const std::string_view src : { "[1, [2, [3]]]", "{\"a\": {\"b\": []}}", "[[[[]]]]" }) {
+        json::internal::lexer lex(src);
+        json::internal::dom_builder builder(std::pmr::get_default_resource());
+        ASSERT_TRUE(json::internal::event_parser<json::internal::dom_builder>(lex, builder, json::default_max_depth, &stack).parse());
+        ASSERT_TRUE(builder.take_result() == json::parse(src));
+      }
+      ASSERT_TRUE(stack.capacity() >= 3);
+    }
     return 0;
 
   }
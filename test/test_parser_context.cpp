@@ -0,0 +1,98 @@
+#include <json/parser_context.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "macros.hpp"
+
+static std::size_t allocations = 0;
+
+void* operator new(const std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static std::string make_request(const int id) {
+  return "{\"id\": " + std::to_string(id) +
+    ", \"user\": \"user-" + std::to_string(id % 7) + "\", \"path\": \"/api/v1/items\\/list\"" +
+    ", \"tags\": [\"a\", \"b\", {\"nested\": [1, 2.5, null, true]}], \"ok\": false}";
+}
+
+int main() {
+
+  // Same results as json::parse, through both entry points
+  {
+    json::parser_context ctx;
+    for (int i = 0; i < 10; ++i) {
+      const auto src = make_request(i);
+      ASSERT_TRUE(ctx.parse(src) == json::parse(src));
+      ASSERT_TRUE(ctx.parse_in_arena(src) == json::parse(src));
+    }
+    ASSERT_TRUE(ctx.parse("[]") == json::array{});
+    ASSERT_TRUE(ctx.parse_in_arena("1") == json::value(1));
+  }
+
+  // The context stays usable after an error
+  {
+    json::parser_context ctx({ .max_depth = 2 });
+    bool threw = false;
+    try { (void)ctx.parse_in_arena("[{\"a\": [1]}]"); }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    threw = false;
+    try { (void)ctx.parse("{\"a\": "); }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    ASSERT_TRUE(ctx.parse_in_arena("[{\"a\": 1}]") == json::parse("[{\"a\": 1}]"));
+  }
+
+  // A document larger than the arena makes it grow before the next parse, which then fits
+  {
+    json::parser_context ctx;
+    std::string big = "[";
+    for (int i = 0; i < 1000; ++i) {
+      big += (i == 0 ? "" : ",") + make_request(i);
+    }
+    big += "]";
+
+    ASSERT_TRUE(ctx.parse_in_arena(big) == json::parse(big));
+    const auto initial = ctx.arena_capacity();
+    ASSERT_TRUE(ctx.parse_in_arena(big) == json::parse(big));
+    const auto grown = ctx.arena_capacity();
+    ASSERT_TRUE(grown > initial);
+    ASSERT_TRUE(ctx.parse_in_arena(big) == json::parse(big));
+    ASSERT_TRUE(ctx.arena_capacity() == grown);
+  }
+
+  // No allocation once warmed up
+  {
+    json::parser_context ctx;
+    std::string src;
+    for (int i = 0; i < 100; ++i) {
+      src = make_request(i);
+      (void)ctx.parse_in_arena(src);
+    }
+
+    src = make_request(12345);
+    const auto before = allocations;
+    const auto& root = ctx.parse_in_arena(src);
+    const auto count = allocations - before;
+
+    std::cout << "allocations: " << count << '\n';
+    ASSERT_TRUE(count == 0);
+    ASSERT_TRUE(root["user"] == json::value("user-4"));
+  }
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <json/push_parser.hpp>
+
+#include <iostream>
+#include <string_view>
+
+#include "macros.hpp"
+
+// Feeds the input in fragments of the given size and checks the values against json::parse
+bool chunked_test(const std::string_view src, const std::vector<std::string_view>& expected, const std::size_t chunk_size) {
+  json::push_parser parser;
+  std::vector<json::value> values;
+
+  for (std::size_t i = 0; i < src.size(); i += chunk_size) {
+    for (auto& v : parser.feed(src.substr(i, chunk_size))) {
+      values.push_back(std::move(v));
+    }
+  }
+  for (auto& v : parser.finish()) {
+    values.push_back(std::move(v));
+  }
+
+  if (values.size() != expected.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (values[i] != json::parse(expected[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+
+  try {
+    const std::string_view doc1 = "{\"a\": [1, 2.5, null, true, false], \"b\\\"\\u00e8\": {\"c\": \"d\\\\e\"}, \"f\": []}";
+    const std::string_view doc2 = "[{}, [[]], \"x\", 12345]";
+    const std::string src = std::string(doc1) + "\n" + std::string(doc2) + " 42 \"str\" null";
+
+    for (std::size_t chunk = 1; chunk <= src.size(); ++chunk) {
+      ASSERT_TRUE(chunked_test(src, { doc1, doc2, "42", "\"str\"", "null" }, chunk));
+    }
+
+    // Values are returned as soon as they are complete
+    {
+      json::push_parser parser;
+      ASSERT_TRUE(parser.feed(std::string_view("[1, 2")).empty());
+      ASSERT_FALSE(parser.idle());
+      const auto values = parser.feed(std::string_view("]{\"a\"")) ;
+      ASSERT_TRUE(values.size() == 1);
+      ASSERT_TRUE(values[0] == json::array({ 1, 2 }));
+      ASSERT_TRUE(parser.feed(std::string_view(": 1}")).size() == 1);
+      ASSERT_TRUE(parser.idle());
+    }
+
+    // Incomplete input
+    {
+      json::push_parser parser;
+      (void)parser.feed(std::string_view("{\"a\": [1"));
+      bool threw = false;
+      try { (void)parser.finish(); }
+      catch (std::runtime_error&) { threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    // Nesting is limited like json::parse, the limit can be raised or lowered
+    {
+      const auto fails = [](const std::string& src, const json::parse_options& options) {
+        json::push_parser parser(options);
+        try {
+          for (std::size_t i = 0; i < src.size(); i += 7) {
+            (void)parser.feed(std::string_view(src).substr(i, 7));
+          }
+          (void)parser.finish();
+        }
+        catch (std::runtime_error&) {
+          return true;
+        }
+        return false;
+      };
+      const auto nested = [](const std::size_t depth) { return std::string(depth, '[') + std::string(depth, ']'); };
+
+      ASSERT_FALSE(fails(nested(json::default_max_depth), {}));
+      ASSERT_TRUE(fails(nested(json::default_max_depth + 1), {}));
+      ASSERT_FALSE(fails(nested(5000), { .max_depth = 5000 }));
+      ASSERT_TRUE(fails("[[1], {\"a\": [2]}]", { .max_depth = 2 }));
+      ASSERT_FALSE(fails("[[1], {\"a\": [2]}]", { .max_depth = 3 }));
+    }
+
+    // Malformed input
+    {
+      json::push_parser parser;
+      bool threw = false;
+      try { (void)parser.feed(std::string_view("[1, }")); }
+      catch (std::runtime_error&) { threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,107 @@
+#include <json/query.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "macros.hpp"
+
+static const std::string_view sample = R"({
+  "meta": {"count": 3, "next": null},
+  "data": {
+    "items": [
+      {"id": 1, "name": "a", "payload": {"blob": [1, [2, "]}"], {"x": "\"{"}]}},
+      {"id": 2, "name": "b", "tags": ["t1", "t2"]},
+      {"name": "c", "id": 3}
+    ]
+  },
+  "a/b": {"m~n": "escaped", "k\"ey": 5},
+  "": 0
+})";
+
+static bool fails(const json::query& q, const std::string_view src, const json::parse_options& options = {}) {
+  try {
+    (void)q.select(src, options);
+  }
+  catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+int main() {
+
+  // Paths, wildcards and array indices
+  {
+    const json::query q{ "/data/items/*/id", "/meta/count", "/data/items/1/tags", "/data/items/5", "/missing/*" };
+    ASSERT_TRUE(q.size() == 5);
+
+    const auto results = q.select(sample);
+    ASSERT_TRUE(results.size() == 5);
+    ASSERT_TRUE(results[0] == (std::vector<json::value>{ 1, 2, 3 }));
+    ASSERT_TRUE(results[1] == std::vector<json::value>{ 3 });
+    ASSERT_TRUE(results[2].size() == 1 && results[2][0] == json::parse(R"(["t1", "t2"])"));
+    ASSERT_TRUE(results[3].empty());
+    ASSERT_TRUE(results[4].empty());
+  }
+
+  // Same values as a full parse
+  {
+    const auto full = json::parse(sample);
+    const json::query q{ "", "/data", "/data/items/0/payload", "/a~1b/m~0n", "/a~1b/k\"ey", "/" };
+    const auto results = q.select(sample);
+    ASSERT_TRUE(results[0].size() == 1 && results[0][0] == full);
+    ASSERT_TRUE(results[1].size() == 1 && results[1][0] == full["data"]);
+    ASSERT_TRUE(results[2].size() == 1 && results[2][0] == full["data"]["items"][0]["payload"]);
+    ASSERT_TRUE(results[3] == std::vector<json::value>{ "escaped" });
+    ASSERT_TRUE(results[4] == std::vector<json::value>{ 5 });
+    ASSERT_TRUE(results[5] == std::vector<json::value>{ 0 });
+  }
+
+  // Pointers sharing a prefix, nested and duplicate targets
+  {
+    const json::query q{ "/data/items/1", "/data/items/1/name", "/data/items/*/name", "/data/items/1/name" };
+    const auto results = q.select(sample);
+    ASSERT_TRUE(results[0].size() == 1 && results[0][0]["id"] == json::value(2));
+    ASSERT_TRUE(results[1] == std::vector<json::value>{ "b" });
+    ASSERT_TRUE(results[2] == (std::vector<json::value>{ "a", "b", "c" }));
+    ASSERT_TRUE(results[3] == std::vector<json::value>{ "b" });
+  }
+
+  // Selected values are validated, skipped ones are only bracket matched
+  {
+    const json::query q{ "/a" };
+    ASSERT_FALSE(fails(q, R"({"b": [1, 2,, 3], "a": 1})"));
+    ASSERT_TRUE(fails(q, R"({"a": [1, 2,, 3]})"));
+    ASSERT_TRUE(fails(q, R"({"b": [1, 2})"));
+    ASSERT_TRUE(fails(q, ""));
+  }
+
+  // Malformed pointers
+  {
+    bool threw = false;
+    try { json::query q{ "data" }; }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    threw = false;
+    try { json::query q{ "/a~2" }; }
+    catch (std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+  }
+
+  // Selected values are parsed within the depth limit, counting the containers above them
+  {
+    const auto nested = [](const std::size_t depth) { return std::string(depth, '[') + std::string(depth, ']'); };
+    const json::query q{ "/a" };
+    const std::string deep = "{\"a\": " + nested(json::default_max_depth) + "}";
+    ASSERT_TRUE(fails(q, deep));
+    ASSERT_FALSE(fails(q, deep, { .max_depth = json::default_max_depth + 1 }));
+    ASSERT_TRUE(q.select(deep, { .max_depth = 5000 })[0][0] == json::parse(nested(json::default_max_depth)));
+    ASSERT_FALSE(fails(q, "{\"a\": [[1]]}", { .max_depth = 3 }));
+    ASSERT_TRUE(fails(q, "{\"a\": [[1]]}", { .max_depth = 2 }));
+  }
+
+  return 0;
+}
@@ -0,0 +1,168 @@
+#include <json/reader.hpp>
+
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "macros.hpp"
+
+struct point {
+  float x{};
+  float y{};
+  std::string name{};
+};
+
+template<>
+class json::serializer<point> {
+public:
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "x", &point::x },
+      json::field{ "y", &point::y },
+      json::field{ "name", &point::name });
+  }
+};
+
+struct shape {
+  std::string kind{};
+  std::vector<point> points{};
+  std::optional<int> layer{};
+  bool visible{};
+  json::value extra{};
+};
+
+template<>
+class json::serializer<shape> {
+public:
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "kind", &shape::kind },
+      json::field{ "points", &shape::points },
+      json::field{ "layer", &shape::layer },
+      json::field{ "visible", &shape::visible },
+      json::field{ "extra", &shape::extra });
+  }
+};
+
+// Only converts from a finished value
+struct color {
+  int r{};
+  int g{};
+  int b{};
+};
+
+template<>
+class json::serializer<color> {
+public:
+  json::value to_json(const color& c) {
+    return json::array{ c.r, c.g, c.b };
+  }
+
+  color from_json(const json::value& v) {
+    const auto& arr = v.get<json::array>();
+    return { arr[0].get<json::number>().as<int>(), arr[1].get<json::number>().as<int>(), arr[2].get<json::number>().as<int>() };
+  }
+};
+
+static_assert(json::described<point>);
+static_assert(!json::described<color>);
+
+static bool fails(const std::string_view src) {
+  try {
+    std::vector<point> points;
+    json::parse_into(src, points);
+  }
+  catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+int main() {
+
+  // Described types are read member by member, unknown keys are skipped
+  {
+    point p;
+    json::parse_into(R"({"name": "a\"b", "unknown": {"deep": [1, {"x": 5}]}, "y": 2.5, "x": -1})", p);
+    ASSERT_TRUE(p.x == -1.0f);
+    ASSERT_TRUE(p.y == 2.5f);
+    ASSERT_TRUE(p.name == "a\"b");
+  }
+
+  // Missing members keep their value
+  {
+    point p{ 1.0f, 2.0f, "keep" };
+    json::parse_into(R"({"x": 3})", p);
+    ASSERT_TRUE(p.x == 3.0f);
+    ASSERT_TRUE(p.y == 2.0f);
+    ASSERT_TRUE(p.name == "keep");
+  }
+
+  // Nested vectors, optionals, values
+  {
+    shape s;
+    json::parse_into(R"({
+      "kind": "polygon",
+      "points": [{"x": 1, "y": 2, "name": "p0"}, {"x": 3, "y": 4, "name": "p1"}],
+      "layer": null,
+      "visible": true,
+      "extra": {"tags": ["a", "b"]}
+    })", s);
+    ASSERT_TRUE(s.kind == "polygon");
+    ASSERT_TRUE(s.points.size() == 2);
+    ASSERT_TRUE(s.points[1].x == 3.0f && s.points[1].name == "p1");
+    ASSERT_FALSE(s.layer.has_value());
+    ASSERT_TRUE(s.visible);
+    ASSERT_TRUE(s.extra == json::parse(R"({"tags": ["a", "b"]})"));
+
+    json::parse_into(R"({"layer": 4, "points": [{"x": 9}]})", s);
+    ASSERT_TRUE(s.layer == 4);
+    ASSERT_TRUE(s.points.size() == 1);
+    ASSERT_TRUE(s.points[0].x == 9.0f && s.points[0].name == "p0");
+  }
+
+  // Same result as going through a tree, for plain and serializable types
+  {
+    std::vector<std::vector<double>> matrix;
+    json::parse_into("[[1, 2], [], [3]]", matrix);
+    ASSERT_TRUE(matrix == (std::vector<std::vector<double>>{ { 1, 2 }, {}, { 3 } }));
+
+    std::vector<color> colors;
+    json::parse_into("[[255, 0, 0], [0, 128, 255]]", colors);
+    ASSERT_TRUE(colors.size() == 2 && colors[1].g == 128 && colors[1].b == 255);
+  }
+
+  // The reader can be driven by hand
+  {
+    json::reader r(R"({"a": [true, null, "s"], "b": 1})");
+    ASSERT_TRUE(r.peek() == json::reader::kind::object);
+    r.begin_object();
+    ASSERT_TRUE(r.next_key() == "a");
+    r.begin_array();
+    ASSERT_TRUE(r.next_element() && r.read_bool());
+    ASSERT_TRUE(r.next_element() && r.peek() == json::reader::kind::null);
+    r.read_null();
+    ASSERT_TRUE(r.next_element() && r.read_string() == "s");
+    ASSERT_FALSE(r.next_element());
+    ASSERT_TRUE(r.next_key() == "b");
+    r.skip();
+    ASSERT_FALSE(r.next_key().has_value());
+  }
+
+  // Malformed input and mismatched kinds throw
+  {
+    ASSERT_FALSE(fails("[]"));
+    ASSERT_FALSE(fails(R"([{"x": 1}, {}])"));
+    ASSERT_TRUE(fails(R"([{"x": "1"}])"));
+    ASSERT_TRUE(fails(R"([{"x": 1,}])"));
+    ASSERT_TRUE(fails(R"([{"x": 1} {"x": 2}])"));
+    ASSERT_TRUE(fails(R"([{"x": 1}, ])"));
+    ASSERT_TRUE(fails(R"([{"other": [1, }])"));
+    ASSERT_TRUE(fails(R"({"x": 1})"));
+    ASSERT_TRUE(fails(R"([{"x": 1})"));
+  }
+
+  return 0;
+}
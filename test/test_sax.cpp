@@ -0,0 +1,74 @@
+#include <json/sax.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "macros.hpp"
+
+// Records every event as a string
+struct recorder {
+  std::vector<std::string> events;
+  std::size_t stop_after = SIZE_MAX;
+
+  bool push(std::string ev) { events.push_back(std::move(ev)); return events.size() < stop_after; }
+
+  bool on_null() { return push("null"); }
+  bool on_bool(const bool b) { return push(b ? "true" : "false"); }
+  bool on_number(const double d) { return push(std::to_string(static_cast<int>(d))); }
+  bool on_string(const std::string_view s) { return push("\"" + std::string(s) + "\""); }
+  bool on_key(const std::string_view s) { return push("key:" + std::string(s)); }
+  bool on_start_object() { return push("{"); }
+  bool on_end_object() { return push("}"); }
+  bool on_start_array() { return push("["); }
+  bool on_end_array() { return push("]"); }
+};
+
+static_assert(json::sax_handler<recorder>);
+
+// Only interested in numbers
+class summer : public json::sax_handler_interface {
+public:
+  double sum = 0;
+  bool on_number(const double d) override { sum += d; return true; }
+};
+
+int main() {
+
+  try {
+    {
+      recorder rec;
+      ASSERT_TRUE(json::parse_sax("{\"a\": [1, null, \"s\", true], \"b\": {}}", rec));
+      const std::vector<std::string> expected = { "{", "key:a", "[", "1", "null", "\"s\"", "true", "]", "key:b", "{", "}", "}" };
+      ASSERT_TRUE(rec.events == expected);
+    }
+
+    // Stop early
+    {
+      recorder rec;
+      rec.stop_after = 3;
+      ASSERT_FALSE(json::parse_sax("[1, 2, 3, 4, 5", rec));
+      ASSERT_TRUE(rec.events.size() == 3);
+    }
+
+    {
+      summer s;
+      ASSERT_TRUE(json::parse_sax("[1, [2, {\"x\": 3}], 4]", s));
+      ASSERT_TRUE(s.sum == 10);
+    }
+
+    {
+      bool threw = false;
+      summer s;
+      try { json::parse_sax("[1, 2", s); }
+      catch (std::runtime_error&) { threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,126 @@
+#include <json/internal/simd.hpp>
+#include <json/internal/lexer.hpp>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <format>
+
+#include "macros.hpp"
+
+using namespace json::internal;
+
+static const simd_level levels[] = { simd_level::scalar, simd_level::sse2, simd_level::avx2 };
+
+bool supported(const simd_level level) {
+  return level <= detected_simd_level();
+}
+
+bool index_test(const std::string& src, const std::vector<std::uint32_t>& expected) {
+  for (const auto level : levels) {
+    if (!supported(level)) continue;
+    structural_index index;
+    build_structural_index(src, index, level);
+    if (index != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool find_test(const std::string& src, const std::size_t expected) {
+  for (const auto level : levels) {
+    if (!supported(level)) continue;
+    if (find_quote_or_backslash(src.data(), src.data() + src.size(), level) != src.data() + expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool escape_test(const std::string& src, const std::size_t expected) {
+  for (const auto level : levels) {
+    if (!supported(level)) continue;
+    if (find_escape(src.data(), src.data() + src.size(), level) != src.data() + expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+
+  try {
+    ASSERT_TRUE(index_test("", {}));
+    ASSERT_TRUE(index_test("  1 ", { 2 }));
+    ASSERT_TRUE(index_test("{\"a\": [1, true]}", { 0, 1, 4, 6, 7, 8, 10, 14, 15 }));
+    ASSERT_TRUE(index_test("\"[{,:}]\"", { 0 }));
+    ASSERT_TRUE(index_test("\"a\\\"b\" 1", { 0, 7 }));
+    ASSERT_TRUE(index_test("\"a\\\\\" 1", { 0, 6 }));
+    ASSERT_TRUE(index_test("12\"a\".5", { 0, 2, 5 }));
+
+    // Strings and escapes crossing 64 byte blocks
+    {
+      const std::string padding(62, ' ');
+      ASSERT_TRUE(index_test(padding + "\"\\\"  \" 1", { 62, 69 }));
+      ASSERT_TRUE(index_test(padding + "\"" + std::string(100, ',') + "\",7", { 62, 164, 165 }));
+    }
+
+    // All levels must agree on a larger document
+    {
+      std::string src = "[";
+      for (int i = 0; i < 500; ++i) {
+        src += std::format("{{\"id\": {}, \"name\": \"item\\\\{}\\\"\", \"tags\": [true, null]}},\n", i, i);
+      }
+      src += "0]";
+
+      structural_index reference;
+      build_structural_index(src, reference, simd_level::scalar);
+      ASSERT_TRUE(index_test(src, reference));
+
+      // The indexed lexer produces the same tokens as the plain one
+      lexer plain(src);
+      lexer indexed(src, reference);
+      while (true) {
+        const auto tok = plain.next_token();
+        ASSERT_TRUE(tok == indexed.next_token());
+        if (tok == token_types::eof{}) break;
+      }
+    }
+
+    // Malformed scalars are still reported when walking the index
+    {
+      const std::string src = "[truex]";
+      structural_index index;
+      build_structural_index(src, index);
+      lexer lex(src, index);
+      lex.next_token();
+      lex.next_token();
+      bool threw = false;
+      try { lex.next_token(); }
+      catch (std::runtime_error&) { threw = true; }
+      ASSERT_TRUE(threw);
+    }
+
+    ASSERT_TRUE(find_test("", 0));
+    ASSERT_TRUE(find_test("abc", 3));
+    ASSERT_TRUE(find_test(std::string(40, 'a') + "\"", 40));
+    ASSERT_TRUE(find_test(std::string(17, 'a') + "\\\"", 17));
+    ASSERT_TRUE(find_test(std::string(100, 'a'), 100));
+
+    ASSERT_TRUE(escape_test("", 0));
+    ASSERT_TRUE(escape_test("abc", 3));
+    ASSERT_TRUE(escape_test(std::string(40, 'a') + "\n", 40));
+    ASSERT_TRUE(escape_test(std::string(17, 'a') + "\x1F", 17));
+    ASSERT_TRUE(escape_test(std::string(33, 'a') + "\\", 33));
+    ASSERT_TRUE(escape_test(std::string(1, '\0'), 0));
+    // Bytes above 0x7F (UTF-8 sequences) and ' ' are copied as they are
+    ASSERT_TRUE(escape_test(std::string(50, '\xC3') + " \x7F\"", 52));
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
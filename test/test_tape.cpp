@@ -0,0 +1,119 @@
+#include <json/tape.hpp>
+
+#include <iostream>
+#include <type_traits>
+
+#include "macros.hpp"
+
+bool roundtrip_test(const std::string_view src) {
+  const json::tape_document doc(src);
+  const json::tape_document interned(src, { .intern_keys = true });
+  return doc.root().to_value() == json::parse(src) && interned.root().to_value() == json::parse(src);
+}
+
+// Views always refer to a document
+static_assert(!std::is_default_constructible_v<json::value_view>);
+static_assert(!std::is_default_constructible_v<json::array_view>);
+static_assert(!std::is_default_constructible_v<json::object_view>);
+
+int main() {
+
+  try {
+    ASSERT_TRUE(roundtrip_test("1"));
+    ASSERT_TRUE(roundtrip_test("\"Hello, World!\""));
+    ASSERT_TRUE(roundtrip_test("null"));
+    ASSERT_TRUE(roundtrip_test("[]"));
+    ASSERT_TRUE(roundtrip_test("{}"));
+    ASSERT_TRUE(roundtrip_test("[1, null, \"Hello\", false, [[]], {\"a\": {}}]"));
+    ASSERT_TRUE(roundtrip_test("{\"a\":1, \"b\": [true, {\"c\": \"d\"}], \"e\": null}"));
+
+    const json::tape_document doc("{\"key1\": [1, \"value2\", {\"key3\": null}], \"key2\": 2.5, \"key4\": true}");
+    const auto root = doc.root();
+
+    ASSERT_TRUE(root.is<json::object>());
+    ASSERT_FALSE(root.is<json::array>());
+    ASSERT_TRUE(root.size() == 3);
+    ASSERT_TRUE(root["key1"].size() == 3);
+    ASSERT_TRUE(root["key1"][0].get<json::number>().value() == 1.0);
+    ASSERT_TRUE(root["key1"][1].get<json::string>() == "value2");
+    ASSERT_TRUE(root["key1"][2]["key3"].is<json::null>());
+    ASSERT_TRUE(root["key2"].get<json::number>().value() == 2.5);
+    ASSERT_TRUE(root["key4"].get<json::boolean>().value());
+    ASSERT_FALSE(root.get<json::object>().contains("key5"));
+
+    // Iteration
+    std::size_t members = 0;
+    for (const auto [key, v] : root.get<json::object>()) {
+      std::cout << key << '\n';
+      ++members;
+    }
+    ASSERT_TRUE(members == 3);
+
+    double sum = 0;
+    for (const auto v : root["key1"].get<json::array>()) {
+      if (v.is<json::number>()) {
+        sum += v.get<json::number>().value();
+      }
+    }
+    ASSERT_TRUE(sum == 1.0);
+
+    // Type mismatches
+    bool threw = false;
+    try { (void)root["key2"].get<json::string>(); }
+    catch (std::bad_variant_access&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    threw = false;
+    try { (void)root["missing"]; }
+    catch (std::out_of_range&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    // Interned keys
+    {
+      const std::string_view src = "[{\"id\": 1, \"name\": \"a\"}, {\"id\": 2, \"name\": \"b\"}, {\"name\": \"c\", \"extra\": {\"id\": 4}}]";
+      const json::tape_document plain(src);
+      const json::tape_document interned(src, { .intern_keys = true });
+
+      ASSERT_TRUE(interned.key_count() == 3);
+      ASSERT_TRUE(plain.key_count() == 0);
+      ASSERT_FALSE(plain.key("id").has_value());
+      ASSERT_FALSE(interned.key("missing").has_value());
+      ASSERT_TRUE(interned.strings().size() < plain.strings().size());
+
+      const auto id = *interned.key("id");
+      const auto name = *interned.key("name");
+      ASSERT_FALSE(id == name);
+
+      const auto records = interned.root();
+      ASSERT_TRUE(records[0][id].get<json::number>().value() == 1.0);
+      ASSERT_TRUE(records[1][name].get<json::string>() == "b");
+      ASSERT_TRUE(records[1]["name"].get<json::string>() == "b");
+      ASSERT_FALSE(records[2].get<json::object>().contains(id));
+      ASSERT_TRUE(records[2]["extra"][id].get<json::number>().value() == 4.0);
+
+      for (const auto [key, v] : records[0].get<json::object>()) {
+        ASSERT_TRUE(key == "id" || key == "name");
+      }
+    }
+
+    // Duplicate keys resolve to the last member, as with json::parse
+    {
+      const std::string_view src = "{\"a\": 1, \"b\": true, \"a\": 2}";
+      const auto expected = json::parse(src)["a"];
+      for (const auto& options : { json::tape_options{}, json::tape_options{ .intern_keys = true } }) {
+        const json::tape_document doc(src, options);
+        ASSERT_TRUE(doc.root()["a"].to_value() == expected);
+        if (options.intern_keys) {
+          ASSERT_TRUE(doc.root()[*doc.key("a")].to_value() == expected);
+        }
+      }
+      ASSERT_TRUE(roundtrip_test(src));
+    }
+
+    return 0;
+  }
+  catch (std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,142 @@
+#include <json/writer.hpp>
+#include <json/reader.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "macros.hpp"
+
+struct point {
+  float x{};
+  float y{};
+  std::string name{};
+};
+
+template<>
+class json::serializer<point> {
+public:
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "x", &point::x },
+      json::field{ "y", &point::y },
+      json::field{ "name", &point::name });
+  }
+};
+
+struct shape {
+  std::vector<point> points{};
+  std::optional<int> layer{};
+};
+
+template<>
+class json::serializer<shape> {
+public:
+  auto fields() {
+    return std::make_tuple(
+      json::field{ "points", &shape::points },
+      json::field{ "layer", &shape::layer });
+  }
+};
+
+// Writes itself as a compact array
+struct rgb {
+  int r{};
+  int g{};
+  int b{};
+};
+
+template<>
+class json::serializer<rgb> {
+public:
+  void write(json::writer& w, const rgb& c) {
+    w.begin_array();
+    w.value(c.r);
+    w.value(c.g);
+    w.value(c.b);
+    w.end_array();
+  }
+};
+
+// Only converts to a finished value
+struct tag {
+  std::string name{};
+};
+
+template<>
+class json::serializer<tag> {
+public:
+  json::value to_json(const tag& t) {
+    return json::object{ {"tag", t.name} };
+  }
+
+  tag from_json(const json::value& v) {
+    return { v["tag"].get<json::string>().value() };
+  }
+};
+
+static_assert(json::writable<rgb>);
+static_assert(!json::writable<point>);
+
+int main() {
+
+  // Calls by hand
+  {
+    std::string out;
+    json::writer w(out);
+    w.begin_object();
+    w.key("a");
+    w.begin_array();
+    w.value(1);
+    w.value(-2.5);
+    w.value(nullptr);
+    w.value(true);
+    w.value("s\"\n");
+    w.begin_object();
+    w.end_object();
+    w.end_array();
+    w.key("b");
+    w.value(json::parse(R"({"c": [1, 2]})"));
+    w.key("raw");
+    w.raw("[3]");
+    w.end_object();
+
+    ASSERT_TRUE(out == R"({"a":[1,-2.5,null,true,"s\"\n",{}],"b":{"c":[1,2]},"raw":[3]})");
+    ASSERT_TRUE(json::parse(out).dump() == out);
+  }
+
+  // Integers are written exactly, beyond the precision of a double
+  {
+    ASSERT_TRUE(json::dump(std::numeric_limits<std::int64_t>::min()) == "-9223372036854775808");
+    ASSERT_TRUE(json::dump(std::numeric_limits<std::uint64_t>::max()) == "18446744073709551615");
+    ASSERT_TRUE(json::dump(0.1) == "0.1");
+  }
+
+  // Built-in support for containers, described, writable and serializable types
+  {
+    const shape s{ { { 1.0f, 2.5f, "a" }, { 3.0f, 4.0f, "b" } }, std::nullopt };
+    const auto text = json::dump(s);
+    ASSERT_TRUE(text == R"({"points":[{"x":1,"y":2.5,"name":"a"},{"x":3,"y":4,"name":"b"}],"layer":null})");
+
+    shape back;
+    json::parse_into(text, back);
+    ASSERT_TRUE(back.points.size() == 2 && back.points[1].name == "b" && !back.layer);
+
+    ASSERT_TRUE(json::dump(std::vector<rgb>{ { 1, 2, 3 }, { 4, 5, 6 } }) == "[[1,2,3],[4,5,6]]");
+    ASSERT_TRUE(json::dump(std::vector<tag>{ { "x" } }) == R"([{"tag":"x"}])");
+    ASSERT_TRUE(json::dump(std::vector<std::optional<bool>>{ true, std::nullopt }) == "[true,null]");
+    ASSERT_TRUE(json::dump(std::vector<std::vector<int>>{ {}, { 1 } }) == "[[],[1]]");
+  }
+
+  // Appends to existing content
+  {
+    std::string out = "data: ";
+    json::dump_to(out, std::vector<std::string>{ "a", "b" });
+    ASSERT_TRUE(out == R"(data: ["a","b"])");
+  }
+
+  return 0;
+}